@@ -0,0 +1,96 @@
+// Cofactor expansion against LU decomposition for the determinant of double N x N matrices, N = 3..10; the
+// crossover backs kCofactorMaxSize in matrix.h.
+// Build and run from the repository root:
+//   g++ -std=c++17 -O2 -I. A_Matrix/bench_determinant.cpp -o bench_determinant && ./bench_determinant
+#include <chrono>
+#include <cstdio>
+#include <utility>
+
+#include "A_Matrix/matrix.h"
+
+namespace {
+
+constexpr double kBudgetMilliseconds = 200.0;
+
+// The generic path of Determinant with LU switched off: expand along the first row down to the unrolled 3x3.
+template <size_t N>
+double CofactorDeterminant(const Matrix<double, N, N>& matrix) {
+  if constexpr (N <= 3) {
+    return Determinant(matrix);
+  } else {
+    double determinant = 0;
+    for (size_t j = 0u; j < N; ++j) {
+      double sign = (j % 2 == 0 ? 1 : -1);
+      determinant += matrix(0, j) * sign * CofactorDeterminant<N - 1>(matrix.TrimMatrix(0, j));
+    }
+    return determinant;
+  }
+}
+
+template <size_t N>
+double LuDeterminant(const Matrix<double, N, N>& matrix) {
+  const LuDecomposition<double, N> decomposition = LuDecompose(matrix);
+  if (decomposition.is_degenerate_) {
+    return 0;
+  }
+  double determinant = decomposition.sign_;
+  for (size_t i = 0u; i < N; ++i) {
+    determinant *= decomposition.lu_matrix_(i, i);
+  }
+  return determinant;
+}
+
+// Mean time of one call in nanoseconds, repeating until the budget is spent.
+template <class Function>
+double NanosecondsPerCall(const Function& function, double& checksum) {
+  size_t calls = 0;
+  auto start = std::chrono::steady_clock::now();
+  double elapsed = 0;
+  do {
+    for (int i = 0; i < 64; ++i) {
+      checksum += function();
+    }
+    calls += 64;
+    elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  } while (elapsed < kBudgetMilliseconds);
+  return elapsed * 1e6 / static_cast<double>(calls);
+}
+
+template <size_t N>
+void RunSize(double& checksum) {
+  Matrix<double, N, N> matrix{};
+  for (size_t i = 0u; i < N; ++i) {
+    for (size_t j = 0u; j < N; ++j) {
+      matrix(i, j) = static_cast<double>((i * 7 + j * 3) % 11) + (i == j ? static_cast<double>(N) : 0.0);
+    }
+  }
+  volatile size_t row = 0;
+  double cofactor = NanosecondsPerCall(
+      [&] {
+        matrix(row, 0) += 1e-9;
+        return CofactorDeterminant<N>(matrix);
+      },
+      checksum);
+  double lu = NanosecondsPerCall(
+      [&] {
+        matrix(row, 0) += 1e-9;
+        return LuDeterminant<N>(matrix);
+      },
+      checksum);
+  std::printf("%4zu %14.1f %14.1f %9.2fx\n", N, cofactor, lu, cofactor / lu);
+}
+
+template <size_t... Ns>
+void RunSizes(std::index_sequence<Ns...>, double& checksum) {
+  (RunSize<Ns + 3>(checksum), ...);
+}
+
+}  // namespace
+
+int main() {
+  double checksum = 0;
+  std::printf("%4s %14s %14s %10s\n", "N", "cofactor ns", "LU ns", "ratio");
+  RunSizes(std::make_index_sequence<8>{}, checksum);
+  std::printf("(checksum %g)\n", checksum);
+  return 0;
+}
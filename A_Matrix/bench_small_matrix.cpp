@@ -0,0 +1,141 @@
+// Unrolled 3x3 and 4x4 kernels (operator*, Determinant, GetInversed) and the batched TransformVectors against the
+// generic loops they replaced: a triple-loop product, cofactor expansion through TrimMatrix and a per-vector loop.
+// Build and run from the repository root:
+//   g++ -std=c++17 -O2 -march=native -I. A_Matrix/bench_small_matrix.cpp -o bench_small_matrix && ./bench_small_matrix
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "A_Matrix/matrix.h"
+
+namespace {
+
+constexpr size_t kBatch = 4096;
+constexpr int kRounds = 200;
+
+template <class T, size_t N>
+Matrix<T, N, N> LoopMultiply(const Matrix<T, N, N>& a, const Matrix<T, N, N>& b) {
+  Matrix<T, N, N> c{};
+  for (size_t i = 0u; i < N; ++i) {
+    for (size_t j = 0u; j < N; ++j) {
+      for (size_t k = 0u; k < N; ++k) {
+        c.inner_matrix_[i][j] += a.inner_matrix_[i][k] * b.inner_matrix_[k][j];
+      }
+    }
+  }
+  return c;
+}
+
+template <class T, size_t N>
+T CofactorDeterminant(const Matrix<T, N, N>& matrix) {
+  if constexpr (N == 1) {
+    return matrix.inner_matrix_[0][0];
+  } else {
+    T determinant = T();
+    for (size_t j = 0u; j < N; ++j) {
+      T sign = (j % 2 == 0 ? T(1) : T(-1));
+      determinant += matrix.inner_matrix_[0][j] * sign * CofactorDeterminant<T, N - 1>(matrix.TrimMatrix(0, j));
+    }
+    return determinant;
+  }
+}
+
+template <class T, size_t N>
+Matrix<T, N, N> CofactorInverse(const Matrix<T, N, N>& matrix) {
+  T determinant = CofactorDeterminant(matrix);
+  Matrix<T, N, N> inverse;
+  for (size_t i = 0u; i < N; ++i) {
+    for (size_t j = 0u; j < N; ++j) {
+      T sign = ((i + j) % 2 == 0 ? T(1) : T(-1));
+      inverse.inner_matrix_[j][i] = sign * CofactorDeterminant(matrix.TrimMatrix(i, j)) / determinant;
+    }
+  }
+  return inverse;
+}
+
+// Nanoseconds per matrix of running operation over the whole batch kRounds times.
+template <class Operation>
+double NanosecondsPerMatrix(const Operation& operation) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < kRounds; ++r) {
+    for (size_t i = 0u; i < kBatch; ++i) {
+      operation(i);
+    }
+  }
+  double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  return elapsed / (static_cast<double>(kRounds) * kBatch);
+}
+
+template <class T, size_t N>
+void RunSize(const char* type_name) {
+  std::vector<Matrix<T, N, N>> matrices(kBatch);
+  for (size_t b = 0u; b < kBatch; ++b) {
+    for (size_t i = 0u; i < N; ++i) {
+      for (size_t j = 0u; j < N; ++j) {
+        matrices[b].inner_matrix_[i][j] = static_cast<T>((b + i * 5 + j * 3) % 7) + (i == j ? T(8) : T(0));
+      }
+    }
+  }
+  std::vector<Matrix<T, N, N>> results(kBatch);
+  std::vector<T> determinants(kBatch);
+
+  double loop_multiply = NanosecondsPerMatrix(
+      [&](size_t i) { results[i] = LoopMultiply(matrices[i], matrices[(i + 1) % kBatch]); });
+  double multiply = NanosecondsPerMatrix([&](size_t i) { results[i] = matrices[i] * matrices[(i + 1) % kBatch]; });
+  double cofactor_determinant =
+      NanosecondsPerMatrix([&](size_t i) { determinants[i] = CofactorDeterminant(matrices[i]); });
+  double determinant = NanosecondsPerMatrix([&](size_t i) { determinants[i] = Determinant(matrices[i]); });
+  double cofactor_inverse = NanosecondsPerMatrix([&](size_t i) { results[i] = CofactorInverse(matrices[i]); });
+  double inverse = NanosecondsPerMatrix([&](size_t i) { results[i] = GetInversed(matrices[i]); });
+
+  std::printf("%-6s %zux%zu  multiply %6.2f -> %6.2f   determinant %6.2f -> %6.2f   inverse %7.2f -> %6.2f\n",
+              type_name, N, N, loop_multiply, multiply, cofactor_determinant, determinant, cofactor_inverse, inverse);
+}
+
+void RunTransform() {
+  constexpr size_t kVectors = 1u << 20;
+  Matrix<float, 4, 4> transform{};
+  for (size_t i = 0u; i < 4; ++i) {
+    for (size_t j = 0u; j < 4; ++j) {
+      transform.inner_matrix_[i][j] = static_cast<float>(i + 2 * j) / 8.0f;
+    }
+  }
+  std::vector<float> input(4 * kVectors);
+  for (size_t i = 0u; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i % 17);
+  }
+  std::vector<float> output(4 * kVectors);
+
+  auto time = [](const auto& function) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < 20; ++r) {
+      function();
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / 20;
+  };
+  double loop = time([&] {
+    for (size_t v = 0u; v < kVectors; ++v) {
+      for (size_t i = 0u; i < 4; ++i) {
+        float sum = 0;
+        for (size_t k = 0u; k < 4; ++k) {
+          sum += transform.inner_matrix_[i][k] * input[4 * v + k];
+        }
+        output[4 * v + i] = sum;
+      }
+    }
+  });
+  double batched = time([&] { TransformVectors(transform, input.data(), output.data(), kVectors); });
+  std::printf("float  4x4  TransformVectors over %zu vectors: loop %.2f ms -> %.2f ms\n", kVectors, loop, batched);
+}
+
+}  // namespace
+
+int main() {
+  std::printf("nanoseconds per matrix, generic loop -> unrolled kernel\n");
+  RunSize<float, 3>("float");
+  RunSize<float, 4>("float");
+  RunSize<double, 3>("double");
+  RunSize<double, 4>("double");
+  RunTransform();
+  return 0;
+}
@@ -0,0 +1,81 @@
+// SparseMatrix (CSR) against dense DynMatrix products at several densities: SpMV with a vector and SpMM with a
+// 64-column dense block, for a 2048 x 2048 double matrix.
+// Build and run from the repository root:
+//   g++ -std=c++17 -O2 -march=native -pthread -I. A_Matrix/bench_sparse_matrix.cpp -o bench_sparse_matrix
+//   ./bench_sparse_matrix
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "A_Matrix/dyn_matrix.h"
+#include "A_Matrix/sparse_matrix.h"
+
+namespace {
+
+constexpr size_t kSize = 2048;
+constexpr size_t kBlockColumns = 64;
+constexpr int kRepeats = 5;
+
+uint64_t NextRandom(uint64_t& state) {
+  state ^= state << 13u;
+  state ^= state >> 7u;
+  state ^= state << 17u;
+  return state;
+}
+
+// Best wall time of kRepeats runs.
+template <class Function>
+double Milliseconds(const Function& function) {
+  double best = 0;
+  for (int r = 0; r < kRepeats; ++r) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    best = (r == 0 ? elapsed : std::min(best, elapsed));
+  }
+  return best;
+}
+
+void RunDensity(double density) {
+  DynMatrix<double> dense(kSize, kSize);
+  uint64_t state = 0x2545F4914F6CDD1Dull;
+  auto threshold = static_cast<uint64_t>(density * 1e6);
+  for (size_t i = 0u; i < kSize; ++i) {
+    for (size_t j = 0u; j < kSize; ++j) {
+      if (NextRandom(state) % 1000000u < threshold) {
+        dense(i, j) = static_cast<double>(NextRandom(state) % 100) / 10.0 + 0.1;
+      }
+    }
+  }
+  SparseMatrix<double> sparse = SparseMatrix<double>::FromDense(dense);
+
+  std::vector<double> vector(kSize);
+  DynMatrix<double> column(kSize, 1);
+  DynMatrix<double> block(kSize, kBlockColumns);
+  for (size_t i = 0u; i < kSize; ++i) {
+    vector[i] = column(i, 0) = static_cast<double>(i % 13);
+    for (size_t j = 0u; j < kBlockColumns; ++j) {
+      block(i, j) = static_cast<double>((i + j) % 7);
+    }
+  }
+
+  double checksum = 0;
+  double dense_mv = Milliseconds([&] { checksum += (dense * column)(0, 0); });
+  double sparse_mv = Milliseconds([&] { checksum += (sparse * vector)[0]; });
+  double dense_mm = Milliseconds([&] { checksum += (dense * block)(0, 0); });
+  double sparse_mm = Milliseconds([&] { checksum += (sparse * block)(0, 0); });
+  std::printf("%7.2f%% %9zu %10.3f %10.3f %10.2f %10.2f   (checksum %g)\n", density * 100, sparse.Values().size(),
+              dense_mv, sparse_mv, dense_mm, sparse_mm, checksum);
+}
+
+}  // namespace
+
+int main() {
+  std::printf("%zu x %zu doubles, best of %d runs, milliseconds\n", kSize, kSize, kRepeats);
+  std::printf("%8s %9s %10s %10s %10s %10s\n", "density", "non-zero", "dense MV", "SpMV", "dense MM", "SpMM");
+  for (double density : {0.001, 0.01, 0.05, 0.2, 0.5}) {
+    RunDensity(density);
+  }
+  return 0;
+}
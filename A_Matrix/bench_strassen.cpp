@@ -0,0 +1,69 @@
+// Strassen-Winograd against the classic blocked product for square double and float matrices of size 512, 1024
+// and 2048, with the largest deviation between the two results; backs kStrassenThreshold in matrix_kernels.h.
+// Build and run from the repository root:
+//   g++ -std=c++17 -O2 -march=native -I. A_Matrix/bench_strassen.cpp -o bench_strassen && ./bench_strassen
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "A_Matrix/matrix_kernels.h"
+
+namespace {
+
+constexpr int kRepeats = 3;
+
+// Best wall time of kRepeats runs.
+template <class Function>
+double Milliseconds(const Function& function) {
+  double best = 0;
+  for (int r = 0; r < kRepeats; ++r) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    best = (r == 0 ? elapsed : std::min(best, elapsed));
+  }
+  return best;
+}
+
+template <class T>
+void RunSize(const char* type_name, size_t n) {
+  std::vector<T> a(n * n);
+  std::vector<T> b(n * n);
+  std::vector<T> classic(n * n);
+  std::vector<T> strassen(n * n);
+  for (size_t i = 0u; i < n * n; ++i) {
+    a[i] = static_cast<T>((i * 7 + 3) % 19) / static_cast<T>(19) - static_cast<T>(0.5);
+    b[i] = static_cast<T>((i * 5 + 1) % 23) / static_cast<T>(23) - static_cast<T>(0.5);
+  }
+
+  double classic_ms = Milliseconds(
+      [&] { matrix_kernels::ClassicMultiply(a.data(), b.data(), classic.data(), n, n, n, n, n, n); });
+  double strassen_ms = Milliseconds([&] {
+    matrix_kernels::ScratchArena<T> arena(matrix_kernels::StrassenScratchSize(n));
+    matrix_kernels::StrassenMultiply(a.data(), b.data(), strassen.data(), n, n, n, n, arena);
+  });
+
+  double max_deviation = 0;
+  for (size_t i = 0u; i < n * n; ++i) {
+    max_deviation = std::max(max_deviation, static_cast<double>(std::abs(classic[i] - strassen[i])));
+  }
+  std::printf("%-6s %5zu %12.1f %12.1f %8.2fx %14.3g\n", type_name, n, classic_ms, strassen_ms,
+              classic_ms / strassen_ms, max_deviation);
+}
+
+}  // namespace
+
+int main() {
+  std::printf("Strassen recursion stops at %zu; Multiply switches to it from %zu on\n",
+              matrix_kernels::kStrassenCutoff, matrix_kernels::kStrassenThreshold);
+  std::printf("%-6s %5s %12s %12s %9s %14s\n", "type", "N", "classic ms", "Strassen ms", "speedup", "max |diff|");
+  for (size_t n : {512u, 1024u, 2048u}) {
+    RunSize<double>("double", n);
+  }
+  for (size_t n : {512u, 1024u, 2048u}) {
+    RunSize<float>("float", n);
+  }
+  return 0;
+}
@@ -0,0 +1,75 @@
+// In-place Transpose and out-of-place GetTransposed against the previous strided loop (transpose into a
+// temporary with a column-stride write, then copy back) for float and double matrices of size 64, 512 and 2048.
+// Build and run from the repository root:
+//   g++ -std=c++17 -O2 -march=native -I. A_Matrix/bench_transpose.cpp -o bench_transpose && ./bench_transpose
+#include <chrono>
+#include <cstdio>
+#include <memory>
+
+#include "A_Matrix/matrix.h"
+
+namespace {
+
+constexpr double kBudgetMilliseconds = 300.0;
+
+// The loop GetTransposed used before the blocked kernels.
+template <class T, size_t N, size_t M>
+void StridedTransposeCopy(const Matrix<T, N, M>& matrix, Matrix<T, M, N>& transposed) {
+  for (size_t i = 0u; i < N; ++i) {
+    for (size_t j = 0u; j < M; ++j) {
+      transposed.inner_matrix_[j][i] = matrix.inner_matrix_[i][j];
+    }
+  }
+}
+
+// Mean time of one call in microseconds, repeating until the budget is spent.
+template <class Function>
+double MicrosecondsPerCall(const Function& function) {
+  size_t calls = 0;
+  auto start = std::chrono::steady_clock::now();
+  double elapsed = 0;
+  do {
+    function();
+    ++calls;
+    elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  } while (elapsed < kBudgetMilliseconds);
+  return elapsed * 1e3 / static_cast<double>(calls);
+}
+
+template <class T, size_t N>
+void RunSize(const char* type_name) {
+  auto matrix = std::make_unique<Matrix<T, N, N>>();
+  auto scratch = std::make_unique<Matrix<T, N, N>>();
+  for (size_t i = 0u; i < N; ++i) {
+    for (size_t j = 0u; j < N; ++j) {
+      (*matrix)(i, j) = static_cast<T>(i * N + j);
+    }
+  }
+
+  double old_in_place = MicrosecondsPerCall([&] {
+    StridedTransposeCopy(*matrix, *scratch);
+    *matrix = *scratch;
+  });
+  double new_in_place = MicrosecondsPerCall([&] { Transpose(*matrix); });
+  double old_copy = MicrosecondsPerCall([&] { StridedTransposeCopy(*matrix, *scratch); });
+  double new_copy = MicrosecondsPerCall([&] {
+    matrix_kernels::TransposeCopy(matrix->inner_matrix_[0], scratch->inner_matrix_[0], N, N, N, N);
+  });
+  std::printf("%-6s %5zu %14.2f %14.2f %14.2f %14.2f\n", type_name, N, old_in_place, new_in_place, old_copy,
+              new_copy);
+}
+
+}  // namespace
+
+int main() {
+  std::printf("%-6s %5s %14s %14s %14s %14s\n", "type", "N", "old Transpose", "Transpose", "old copy",
+              "GetTransposed");
+  std::printf("(microseconds per call)\n");
+  RunSize<float, 64>("float");
+  RunSize<float, 512>("float");
+  RunSize<float, 2048>("float");
+  RunSize<double, 64>("double");
+  RunSize<double, 512>("double");
+  RunSize<double, 2048>("double");
+  return 0;
+}
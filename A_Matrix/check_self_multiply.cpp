@@ -0,0 +1,31 @@
+// Regression check: m *= m must equal m * m even though MultiplyInPlace overwrites m band by band.
+// Build and run from the repository root:
+//   g++ -std=c++17 -O2 -I. A_Matrix/check_self_multiply.cpp -o check_self_multiply && ./check_self_multiply
+#include <cstdio>
+
+#include "A_Matrix/matrix.h"
+
+template <class T, size_t N>
+bool CheckSelfMultiply() {
+  Matrix<T, N, N> m{};
+  for (size_t i = 0u; i < N; ++i) {
+    for (size_t j = 0u; j < N; ++j) {
+      m(i, j) = static_cast<T>((i * 7 + j * 3) % 5) - static_cast<T>(2);
+    }
+  }
+  Matrix<T, N, N> expected = m * m;
+  m *= m;
+  if (!(m == expected)) {
+    std::printf("m *= m differs from m * m for %zux%zu\n", N, N);
+    return false;
+  }
+  return true;
+}
+
+int main() {
+  bool ok = CheckSelfMultiply<int32_t, 3>() && CheckSelfMultiply<int32_t, 8>() && CheckSelfMultiply<int32_t, 40>() &&
+            CheckSelfMultiply<double, 3>() && CheckSelfMultiply<double, 8>() && CheckSelfMultiply<double, 40>() &&
+            CheckSelfMultiply<float, 100>();
+  std::puts(ok ? "ok" : "FAILED");
+  return ok ? 0 : 1;
+}
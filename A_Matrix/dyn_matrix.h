@@ -0,0 +1,393 @@
+#ifndef LARGETASKS_DYN_MATRIX_H
+#define LARGETASKS_DYN_MATRIX_H
+
+#include <cmath>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "matrix.h"
+#include "matrix_kernels.h"
+#include "matrix_text.h"
+
+template <class T>
+class DynMatrix {
+ private:
+  static constexpr size_t kAlignment = 64;
+
+  T* data_ = nullptr;
+  size_t rows_ = 0;
+  size_t columns_ = 0;
+  size_t stride_ = 0;
+
+  static size_t DefaultStride(size_t columns) {
+    if constexpr (kAlignment % sizeof(T) == 0) {
+      constexpr size_t kLineElements = kAlignment / sizeof(T);
+      return (columns + kLineElements - 1) / kLineElements * kLineElements;
+    }
+    return columns;
+  }
+
+  void Allocate(size_t rows, size_t columns, size_t stride) {
+    if (stride < columns) {
+      throw MatrixInvalidDimensions{};
+    }
+    size_t n_elements = rows * stride;
+    T* data = static_cast<T*>(::operator new(n_elements * sizeof(T), std::align_val_t{kAlignment}));
+    try {
+      std::uninitialized_value_construct_n(data, n_elements);
+    } catch (...) {
+      ::operator delete(data, std::align_val_t{kAlignment});
+      throw;
+    }
+    data_ = data;
+    rows_ = rows;
+    columns_ = columns;
+    stride_ = stride;
+  }
+
+  void Release() noexcept {
+    if (data_ != nullptr) {
+      std::destroy_n(data_, rows_ * stride_);
+      ::operator delete(data_, std::align_val_t{kAlignment});
+    }
+    data_ = nullptr;
+    rows_ = 0;
+    columns_ = 0;
+    stride_ = 0;
+  }
+
+  void CheckSameDimensions(const DynMatrix<T>& other) const {
+    if (rows_ != other.rows_ || columns_ != other.columns_) {
+      throw MatrixInvalidDimensions{};
+    }
+  }
+
+ public:
+  DynMatrix() noexcept = default;
+
+  DynMatrix(size_t rows, size_t columns) : DynMatrix(rows, columns, DefaultStride(columns)) {
+  }
+
+  DynMatrix(size_t rows, size_t columns, size_t stride) {
+    Allocate(rows, columns, stride);
+  }
+
+  template <size_t N, size_t M>
+  explicit DynMatrix(const Matrix<T, N, M>& matrix) : DynMatrix(N, M) {
+    for (size_t i = 0u; i < N; ++i) {
+      std::copy(matrix.inner_matrix_[i], matrix.inner_matrix_[i] + M, Row(i));
+    }
+  }
+
+  DynMatrix(const DynMatrix<T>& other) : DynMatrix(other.rows_, other.columns_, other.stride_) {
+    for (size_t i = 0u; i < rows_; ++i) {
+      std::copy(other.Row(i), other.Row(i) + columns_, Row(i));
+    }
+  }
+
+  DynMatrix<T>& operator=(const DynMatrix<T>& other) {
+    if (this != &other) {
+      DynMatrix<T> copy(other);
+      Swap(copy);
+    }
+    return *this;
+  }
+
+  DynMatrix(DynMatrix<T>&& rvalue_matrix) noexcept {
+    Swap(rvalue_matrix);
+  }
+
+  DynMatrix<T>& operator=(DynMatrix<T>&& rvalue_matrix) noexcept {
+    if (this != &rvalue_matrix) {
+      Release();
+      Swap(rvalue_matrix);
+    }
+    return *this;
+  }
+
+  template <size_t N, size_t M>
+  Matrix<T, N, M> ToMatrix() const {
+    if (rows_ != N || columns_ != M) {
+      throw MatrixInvalidDimensions{};
+    }
+    Matrix<T, N, M> matrix;
+    for (size_t i = 0u; i < N; ++i) {
+      std::copy(Row(i), Row(i) + M, matrix.inner_matrix_[i]);
+    }
+    return matrix;
+  }
+
+  void Swap(DynMatrix<T>& other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(rows_, other.rows_);
+    std::swap(columns_, other.columns_);
+    std::swap(stride_, other.stride_);
+  }
+
+  [[nodiscard]] size_t RowsNumber() const noexcept {
+    return rows_;
+  }
+
+  [[nodiscard]] size_t ColumnsNumber() const noexcept {
+    return columns_;
+  }
+
+  [[nodiscard]] size_t Stride() const noexcept {
+    return stride_;
+  }
+
+  T* Data() noexcept {
+    return data_;
+  }
+
+  const T* Data() const noexcept {
+    return data_;
+  }
+
+  T* Row(size_t n) noexcept {
+    return data_ + n * stride_;
+  }
+
+  const T* Row(size_t n) const noexcept {
+    return data_ + n * stride_;
+  }
+
+  T& operator()(size_t n, size_t m) {
+    return data_[n * stride_ + m];
+  }
+
+  const T& operator()(size_t n, size_t m) const {
+    return data_[n * stride_ + m];
+  }
+
+  T& At(size_t n, size_t m) {
+    if (n >= rows_ || m >= columns_) {
+      throw MatrixOutOfRange();
+    }
+    return data_[n * stride_ + m];
+  }
+
+  const T& At(size_t n, size_t m) const {
+    if (n >= rows_ || m >= columns_) {
+      throw MatrixOutOfRange();
+    }
+    return data_[n * stride_ + m];
+  }
+
+  DynMatrix<T> operator+(const DynMatrix<T>& other) const {
+    DynMatrix<T> new_matrix(*this);
+    new_matrix += other;
+    return new_matrix;
+  }
+
+  DynMatrix<T>& operator+=(const DynMatrix<T>& other) {
+    CheckSameDimensions(other);
+    for (size_t i = 0u; i < rows_; ++i) {
+      T* row = Row(i);
+      const T* other_row = other.Row(i);
+      for (size_t j = 0u; j < columns_; ++j) {
+        row[j] += other_row[j];
+      }
+    }
+    return *this;
+  }
+
+  DynMatrix<T> operator-(const DynMatrix<T>& other) const {
+    DynMatrix<T> new_matrix(*this);
+    new_matrix -= other;
+    return new_matrix;
+  }
+
+  DynMatrix<T>& operator-=(const DynMatrix<T>& other) {
+    CheckSameDimensions(other);
+    for (size_t i = 0u; i < rows_; ++i) {
+      T* row = Row(i);
+      const T* other_row = other.Row(i);
+      for (size_t j = 0u; j < columns_; ++j) {
+        row[j] -= other_row[j];
+      }
+    }
+    return *this;
+  }
+
+  DynMatrix<T> operator*(const DynMatrix<T>& other) const {
+    if (columns_ != other.rows_) {
+      throw MatrixInvalidDimensions{};
+    }
+    DynMatrix<T> new_matrix(rows_, other.columns_);
+    matrix_kernels::Multiply(data_, other.data_, new_matrix.data_, rows_, columns_, other.columns_, stride_,
+                             other.stride_, new_matrix.stride_);
+    return new_matrix;
+  }
+
+  DynMatrix<T>& operator*=(const DynMatrix<T>& other) {
+    *this = *this * other;
+    return *this;
+  }
+
+  DynMatrix<T> operator*(const T& num) const {
+    DynMatrix<T> new_matrix(*this);
+    new_matrix *= num;
+    return new_matrix;
+  }
+
+  friend DynMatrix<T> operator*(const T& num, const DynMatrix<T>& matrix) {
+    return matrix * num;
+  }
+
+  DynMatrix<T>& operator*=(const T& num) {
+    for (size_t i = 0u; i < rows_; ++i) {
+      T* row = Row(i);
+      for (size_t j = 0u; j < columns_; ++j) {
+        row[j] *= num;
+      }
+    }
+    return *this;
+  }
+
+  template <class W>
+  DynMatrix<T> operator/(const W& num) const {
+    DynMatrix<T> new_matrix(*this);
+    new_matrix /= num;
+    return new_matrix;
+  }
+
+  template <class W>
+  DynMatrix<T>& operator/=(const W& num) {
+    for (size_t i = 0u; i < rows_; ++i) {
+      T* row = Row(i);
+      for (size_t j = 0u; j < columns_; ++j) {
+        row[j] /= num;
+      }
+    }
+    return *this;
+  }
+
+  bool operator==(const DynMatrix<T>& other) const {
+    if (rows_ != other.rows_ || columns_ != other.columns_) {
+      return false;
+    }
+    for (size_t i = 0u; i < rows_; ++i) {
+      if (!std::equal(Row(i), Row(i) + columns_, other.Row(i))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool operator!=(const DynMatrix<T>& other) const {
+    return !(*this == other);
+  }
+
+  friend std::istream& operator>>(std::istream& is, DynMatrix<T>& matrix) {
+    for (size_t i = 0u; i < matrix.rows_; ++i) {
+      for (size_t j = 0u; j < matrix.columns_; ++j) {
+        matrix_text::ReadValue(is, matrix(i, j));
+      }
+    }
+    return is;
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, const DynMatrix<T>& matrix) {
+    for (size_t i = 0u; i < matrix.rows_; ++i) {
+      for (size_t j = 0u; j < matrix.columns_; ++j) {
+        os << matrix(i, j) << (j == matrix.columns_ - 1 ? "\n" : " ");
+      }
+    }
+    return os;
+  }
+
+  ~DynMatrix() {
+    Release();
+  }
+};
+
+template <class T>
+T Trace(const DynMatrix<T>& matrix) {
+  if (matrix.RowsNumber() != matrix.ColumnsNumber()) {
+    throw MatrixInvalidDimensions{};
+  }
+  T matrix_trace = T();
+  for (size_t i = 0u; i < matrix.RowsNumber(); ++i) {
+    matrix_trace += matrix(i, i);
+  }
+  return matrix_trace;
+}
+
+template <class T>
+DynMatrix<T> GetTransposed(const DynMatrix<T>& matrix) {
+  DynMatrix<T> transposed_matrix(matrix.ColumnsNumber(), matrix.RowsNumber());
+  matrix_kernels::TransposeCopy(matrix.Data(), transposed_matrix.Data(), matrix.RowsNumber(), matrix.ColumnsNumber(),
+                                matrix.Stride(), transposed_matrix.Stride());
+  return transposed_matrix;
+}
+
+// Floating-point T uses Gaussian elimination with partial pivoting; any other T uses the fraction-free
+// Bareiss elimination, which only ever divides exactly and so stays correct for integers.
+template <class T>
+T Determinant(const DynMatrix<T>& matrix) {
+  size_t n = matrix.RowsNumber();
+  if (n != matrix.ColumnsNumber()) {
+    throw MatrixInvalidDimensions{};
+  }
+  if (n == 0) {
+    return T(1);
+  }
+
+  DynMatrix<T> work(matrix);
+  bool negate = false;
+  T previous_pivot = T(1);
+  for (size_t k = 0u; k < n; ++k) {
+    size_t pivot = k;
+    if constexpr (std::is_floating_point_v<T>) {
+      for (size_t i = k + 1; i < n; ++i) {
+        if (std::abs(work(i, k)) > std::abs(work(pivot, k))) {
+          pivot = i;
+        }
+      }
+    } else {
+      while (pivot < n && work(pivot, k) == T()) {
+        ++pivot;
+      }
+    }
+    if (pivot == n || work(pivot, k) == T()) {
+      return T();
+    }
+    if (pivot != k) {
+      std::swap_ranges(work.Row(k), work.Row(k) + n, work.Row(pivot));
+      negate = !negate;
+    }
+
+    for (size_t i = k + 1; i < n; ++i) {
+      if constexpr (std::is_floating_point_v<T>) {
+        const T factor = work(i, k) / work(k, k);
+        for (size_t j = k + 1; j < n; ++j) {
+          work(i, j) -= factor * work(k, j);
+        }
+      } else {
+        for (size_t j = k + 1; j < n; ++j) {
+          work(i, j) = (work(i, j) * work(k, k) - work(i, k) * work(k, j)) / previous_pivot;
+        }
+      }
+    }
+    previous_pivot = work(k, k);
+  }
+
+  T matrix_determinant = T(1);
+  if constexpr (std::is_floating_point_v<T>) {
+    for (size_t i = 0u; i < n; ++i) {
+      matrix_determinant *= work(i, i);
+    }
+  } else {
+    matrix_determinant = work(n - 1, n - 1);
+  }
+  return negate ? -matrix_determinant : matrix_determinant;
+}
+
+#endif
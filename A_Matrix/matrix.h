@@ -7,6 +7,12 @@
 #include <istream>
 #include <ostream>
 #include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include "matrix_expressions.h"
+#include "matrix_kernels.h"
+#include "matrix_text.h"
 
 class MatrixOutOfRange {};
 class MatrixInvalidDimensions : std::exception {};
@@ -15,6 +21,10 @@ class MatrixIsDegenerateError {};
 template <class T, size_t N, size_t M>
 class Matrix {
  public:
+  using ValueType = T;
+  static constexpr size_t kRows = N;
+  static constexpr size_t kColumns = M;
+
   Matrix<T, N - 1, M - 1> TrimMatrix(size_t i_d, size_t j_d) const {
     Matrix<T, N - 1, M - 1> trimmed_matrix;
     int32_t i_offset = 0;
@@ -54,6 +64,13 @@ class Matrix {
     return inner_matrix_[n][m];
   }
 
+  template <class E, std::enable_if_t<kIsMatrixNode<E>, int> = 0>
+  Matrix<T, N, M>& operator=(const E& expression) {
+    static_assert(E::kRows == N && E::kColumns == M, "assigned expression must have the same dimensions");
+    expression.AssignTo(*this);
+    return *this;
+  }
+
   T& At(size_t n, size_t m) {
     if (n >= N || m >= M) {
       throw MatrixOutOfRange();
@@ -68,61 +85,43 @@ class Matrix {
     return inner_matrix_[n][m];
   }
 
-  Matrix<T, N, M> operator+(const Matrix<T, N, M>& other) const {
-    Matrix<T, N, M> new_matrix;
-    for (size_t i = 0u; i < N; ++i) {
-      for (size_t j = 0u; j < M; ++j) {
-        new_matrix(i, j) = inner_matrix_[i][j] + other(i, j);
-      }
-    }
-    return new_matrix;
-  }
-
-  Matrix<T, N, M>& operator+=(const Matrix<T, N, M>& other) {
+  template <class E, std::enable_if_t<kIsMatrixExpression<E>, int> = 0>
+  Matrix<T, N, M>& operator+=(const E& other) {
+    static_assert(E::kRows == N && E::kColumns == M, "element-wise matrix operands must have the same dimensions");
     for (size_t i = 0; i < N; ++i) {
       for (size_t j = 0; j < M; ++j) {
-        this->inner_matrix_[i][j] += other.inner_matrix_[i][j];
+        this->inner_matrix_[i][j] += other(i, j);
       }
     }
     return *this;
   }
 
-  Matrix<T, N, M> operator-(const Matrix<T, N, M>& other) const {
-    Matrix<T, N, M> new_matrix;
-    for (size_t i = 0u; i < N; ++i) {
-      for (size_t j = 0u; j < M; ++j) {
-        new_matrix(i, j) = inner_matrix_[i][j] - other(i, j);
-      }
-    }
-    return new_matrix;
-  }
-
-  Matrix<T, N, M>& operator-=(const Matrix<T, N, M>& other) {
+  template <class E, std::enable_if_t<kIsMatrixExpression<E>, int> = 0>
+  Matrix<T, N, M>& operator-=(const E& other) {
+    static_assert(E::kRows == N && E::kColumns == M, "element-wise matrix operands must have the same dimensions");
     for (size_t i = 0; i < N; ++i) {
       for (size_t j = 0; j < M; ++j) {
-        this->inner_matrix_[i][j] -= other.inner_matrix_[i][j];
+        this->inner_matrix_[i][j] -= other(i, j);
       }
     }
     return *this;
   }
 
   template <size_t M1, size_t W>
-  Matrix<T, N, W> operator*(const Matrix<T, M1, W>& other) const{
+  constexpr Matrix<T, N, W> operator*(const Matrix<T, M1, W>& other) const {
     if (M != M1) {
       throw MatrixInvalidDimensions{};
     }
-    Matrix<T, N, W> new_matrix;
-    for (size_t i = 0u; i < N; ++i) {
-      for (size_t w = 0u; w < W; ++w) {
-        T nw_temp_value = T();
-        for (size_t j = 0u; j < M; ++j) {
-          nw_temp_value += this->inner_matrix_[i][j] * other.inner_matrix_[j][w];
-        }
-        new_matrix.inner_matrix_[i][w] = nw_temp_value;
-      }
+    if constexpr (matrix_kernels::kIsSmallProduct<N, M, W>) {
+      Matrix<T, N, W> new_matrix{};
+      matrix_kernels::SmallMultiply(inner_matrix_, other.inner_matrix_, new_matrix.inner_matrix_);
+      return new_matrix;
+    } else {
+      Matrix<T, N, W> new_matrix;
+      matrix_kernels::Multiply(inner_matrix_[0], other.inner_matrix_[0], new_matrix.inner_matrix_[0], N, M, W, M, W,
+                               W);
+      return new_matrix;
     }
-
-    return new_matrix;
   }
 
   template <size_t M1, size_t W>
@@ -130,18 +129,8 @@ class Matrix {
     if (M != M1) {
       throw MatrixInvalidDimensions{};
     }
-    Matrix<T, N, W> almost_new_matrix;
-    for (size_t w = 0u; w < W; ++w) {
-      for (size_t i = 0u; i < N; ++i) {
-        T nw_temp_value = T();
-        for (size_t j = 0u; j < M; ++j) {
-          nw_temp_value += this->inner_matrix_[i][j] * other.inner_matrix_[j][w];
-        }
-        almost_new_matrix.inner_matrix_[i][w] = nw_temp_value;
-      }
-    }
-
-    *this = almost_new_matrix;
+    static_assert(M == W, "operator*= requires a square right-hand side");
+    matrix_kernels::MultiplyInPlace<T, N, M>(inner_matrix_[0], other.inner_matrix_[0]);
     return *this;
   }
 
@@ -167,21 +156,6 @@ class Matrix {
     return false;
   }
 
-  Matrix<T, N, M> operator*(const T& num) const {
-    Matrix<T, N, M> new_matrix;
-    for (size_t i = 0; i < N; ++i) {
-      for (size_t j = 0; j < M; ++j) {
-        new_matrix.inner_matrix_[i][j] = this->inner_matrix_[i][j] * num;
-      }
-    }
-    return new_matrix;
-  }
-
-  friend Matrix<T, N, M> operator*(const T& num, Matrix<T, N, M> matrix) {
-    Matrix<T, N, M> new_matrix = matrix * num;
-    return new_matrix;
-  }
-
   Matrix<T, N, M>& operator*=(const T& num) {
     for (size_t i = 0; i < N; ++i) {
       for (size_t j = 0; j < M; ++j) {
@@ -192,17 +166,6 @@ class Matrix {
     return *this;
   }
 
-  template <class W>
-  Matrix<T, N, M> operator/(const W& num) const {
-    Matrix<T, N, M> new_matrix;
-    for (size_t i = 0; i < N; ++i) {
-      for (size_t j = 0; j < M; ++j) {
-        new_matrix.inner_matrix_[i][j] = this->inner_matrix_[i][j] / num;
-      }
-    }
-    return new_matrix;
-  }
-
   template <class W>
   Matrix<T, N, M>& operator/=(const W& num) {
     for (size_t i = 0; i < N; ++i) {
@@ -217,7 +180,7 @@ class Matrix {
   friend std::istream& operator>>(std::istream& is, Matrix<T, N, M>& matrix) {
     for (size_t i = 0u; i < N; ++i) {
       for (size_t j = 0u; j < M; ++j) {
-        is >> matrix.inner_matrix_[i][j];
+        matrix_text::ReadValue(is, matrix.inner_matrix_[i][j]);
       }
     }
 
@@ -236,16 +199,136 @@ class Matrix {
   ~Matrix() = default;
 };
 
+// Cofactor expansion stays exact for integral and user-defined T; floating-point matrices past this size
+// go through the O(N^3) LU decomposition instead. Generic cofactor expansion already loses to LU at N = 4 and
+// is 6x slower at N = 5 (A_Matrix/bench_determinant.cpp); sizes up to 4 have unrolled overloads either way.
+// Define MATRIX_COFACTOR_MAX_SIZE to move the crossover, e.g. to keep cofactor results for a few more sizes.
+#if defined(MATRIX_COFACTOR_MAX_SIZE)
+constexpr size_t kCofactorMaxSize = MATRIX_COFACTOR_MAX_SIZE;
+#else
+constexpr size_t kCofactorMaxSize = 3;
+#endif
+
 template <class T, size_t N>
-constexpr T Determinant(const Matrix<T, N, N>& matrix) {
-  T matrix_determinant = T();
-  for (size_t j = 0u; j < N; ++j) {
-    int32_t sign = (j % 2 == 0 ? 1 : -1);
-    Matrix<T, N - 1, N - 1> matrix_part = matrix.TrimMatrix(0, j);
-    matrix_determinant += matrix.inner_matrix_[0][j] * sign * Determinant(matrix_part);
+constexpr bool kUseLuDecomposition = std::is_floating_point_v<T> && (N > kCofactorMaxSize);
+
+template <class T, size_t N>
+struct LuDecomposition {
+  Matrix<T, N, N> lu_matrix_;
+  size_t permutation_[N];
+  int32_t sign_;
+  bool is_degenerate_;
+};
+
+template <class T, size_t N>
+constexpr LuDecomposition<T, N> LuDecompose(const Matrix<T, N, N>& matrix) {
+  auto abs_value = [](const T& value) { return value < T() ? -value : value; };
+
+  LuDecomposition<T, N> decomposition{matrix, {}, 1, false};
+  auto& lu = decomposition.lu_matrix_.inner_matrix_;
+  for (size_t i = 0u; i < N; ++i) {
+    decomposition.permutation_[i] = i;
   }
 
-  return matrix_determinant;
+  for (size_t k = 0u; k < N; ++k) {
+    size_t pivot = k;
+    T pivot_value = abs_value(lu[k][k]);
+    for (size_t i = k + 1; i < N; ++i) {
+      if (abs_value(lu[i][k]) > pivot_value) {
+        pivot = i;
+        pivot_value = abs_value(lu[i][k]);
+      }
+    }
+    if (pivot_value == T()) {
+      decomposition.is_degenerate_ = true;
+      continue;
+    }
+
+    if (pivot != k) {
+      for (size_t j = 0u; j < N; ++j) {
+        T tmp = lu[k][j];
+        lu[k][j] = lu[pivot][j];
+        lu[pivot][j] = tmp;
+      }
+      size_t tmp_index = decomposition.permutation_[k];
+      decomposition.permutation_[k] = decomposition.permutation_[pivot];
+      decomposition.permutation_[pivot] = tmp_index;
+      decomposition.sign_ = -decomposition.sign_;
+    }
+
+    for (size_t i = k + 1; i < N; ++i) {
+      lu[i][k] /= lu[k][k];
+      const T factor = lu[i][k];
+      for (size_t j = k + 1; j < N; ++j) {
+        lu[i][j] -= factor * lu[k][j];
+      }
+    }
+  }
+
+  return decomposition;
+}
+
+template <class T, size_t N, size_t K>
+constexpr Matrix<T, N, K> LuSolve(const LuDecomposition<T, N>& decomposition, const Matrix<T, N, K>& rhs) {
+  if (decomposition.is_degenerate_) {
+    throw MatrixIsDegenerateError{};
+  }
+  const auto& lu = decomposition.lu_matrix_.inner_matrix_;
+  Matrix<T, N, K> solution{};
+
+  for (size_t i = 0u; i < N; ++i) {
+    for (size_t k = 0u; k < K; ++k) {
+      solution.inner_matrix_[i][k] = rhs.inner_matrix_[decomposition.permutation_[i]][k];
+    }
+    for (size_t j = 0u; j < i; ++j) {
+      const T factor = lu[i][j];
+      for (size_t k = 0u; k < K; ++k) {
+        solution.inner_matrix_[i][k] -= factor * solution.inner_matrix_[j][k];
+      }
+    }
+  }
+
+  for (size_t i = N; i-- > 0u;) {
+    for (size_t j = i + 1; j < N; ++j) {
+      const T factor = lu[i][j];
+      for (size_t k = 0u; k < K; ++k) {
+        solution.inner_matrix_[i][k] -= factor * solution.inner_matrix_[j][k];
+      }
+    }
+    for (size_t k = 0u; k < K; ++k) {
+      solution.inner_matrix_[i][k] /= lu[i][i];
+    }
+  }
+
+  return solution;
+}
+
+template <class T, size_t N, size_t K>
+constexpr Matrix<T, N, K> Solve(const Matrix<T, N, N>& matrix, const Matrix<T, N, K>& rhs) {
+  return LuSolve(LuDecompose(matrix), rhs);
+}
+
+template <class T, size_t N>
+constexpr T Determinant(const Matrix<T, N, N>& matrix) {
+  if constexpr (kUseLuDecomposition<T, N>) {
+    const LuDecomposition<T, N> decomposition = LuDecompose(matrix);
+    if (decomposition.is_degenerate_) {
+      return T();
+    }
+    T matrix_determinant = static_cast<T>(decomposition.sign_);
+    for (size_t i = 0u; i < N; ++i) {
+      matrix_determinant *= decomposition.lu_matrix_.inner_matrix_[i][i];
+    }
+    return matrix_determinant;
+  } else {
+    T matrix_determinant = T();
+    for (size_t j = 0u; j < N; ++j) {
+      int32_t sign = (j % 2 == 0 ? 1 : -1);
+      Matrix<T, N - 1, N - 1> matrix_part = matrix.TrimMatrix(0, j);
+      matrix_determinant += matrix.inner_matrix_[0][j] * sign * Determinant(matrix_part);
+    }
+    return matrix_determinant;
+  }
 }
 
 template <class T>
@@ -259,6 +342,38 @@ constexpr T Determinant(const Matrix<T, 2, 2>& matrix) {
          matrix.inner_matrix_[0][1] * matrix.inner_matrix_[1][0];
 }
 
+template <class T>
+constexpr T Determinant(const Matrix<T, 3, 3>& matrix) {
+  const auto& a = matrix.inner_matrix_;
+  return a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) - a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+         a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+}
+
+// 2x2 minors of the top two rows (s) and the bottom two rows (c), shared by the 4x4 determinant and inverse.
+template <class T>
+struct Minors4x4 {
+  T s_[6];
+  T c_[6];
+};
+
+template <class T>
+constexpr Minors4x4<T> GetMinors4x4(const Matrix<T, 4, 4>& matrix) {
+  const auto& a = matrix.inner_matrix_;
+  return {{a[0][0] * a[1][1] - a[1][0] * a[0][1], a[0][0] * a[1][2] - a[1][0] * a[0][2],
+           a[0][0] * a[1][3] - a[1][0] * a[0][3], a[0][1] * a[1][2] - a[1][1] * a[0][2],
+           a[0][1] * a[1][3] - a[1][1] * a[0][3], a[0][2] * a[1][3] - a[1][2] * a[0][3]},
+          {a[2][0] * a[3][1] - a[3][0] * a[2][1], a[2][0] * a[3][2] - a[3][0] * a[2][2],
+           a[2][0] * a[3][3] - a[3][0] * a[2][3], a[2][1] * a[3][2] - a[3][1] * a[2][2],
+           a[2][1] * a[3][3] - a[3][1] * a[2][3], a[2][2] * a[3][3] - a[3][2] * a[2][3]}};
+}
+
+template <class T>
+constexpr T Determinant(const Matrix<T, 4, 4>& matrix) {
+  const Minors4x4<T> m = GetMinors4x4(matrix);
+  return m.s_[0] * m.c_[5] - m.s_[1] * m.c_[4] + m.s_[2] * m.c_[3] + m.s_[3] * m.c_[2] - m.s_[4] * m.c_[1] +
+         m.s_[5] * m.c_[0];
+}
+
 template <class T, size_t N>
 T Trace(const Matrix<T, N, N>& matrix) {
   T matrix_trace = T();
@@ -269,41 +384,54 @@ T Trace(const Matrix<T, N, N>& matrix) {
 }
 
 template <class T, size_t N, size_t M>
-Matrix<T, M, N> GetTransposed(const Matrix<T, N, M>& matrix) {
-  Matrix<T, M, N> transposed_matrix;
-  for (size_t i = 0; i < N; i++) {
-    for (size_t j = 0; j < M; ++j) {
-      transposed_matrix.inner_matrix_[j][i] = matrix.inner_matrix_[i][j];
-    }
+constexpr Matrix<T, M, N> GetTransposed(const Matrix<T, N, M>& matrix) {
+  if constexpr (N <= matrix_kernels::kSmallMatrixSize && M <= matrix_kernels::kSmallMatrixSize) {
+    Matrix<T, M, N> transposed_matrix{};
+    matrix_kernels::SmallTransposeCopy(matrix.inner_matrix_, transposed_matrix.inner_matrix_,
+                                       std::make_index_sequence<N * M>{});
+    return transposed_matrix;
+  } else {
+    Matrix<T, M, N> transposed_matrix;
+    matrix_kernels::TransposeCopy(matrix.inner_matrix_[0], transposed_matrix.inner_matrix_[0], N, M, M, N);
+    return transposed_matrix;
   }
-
-  return transposed_matrix;
 }
+
 template <class T, size_t N>
-void Transpose(Matrix<T, N, N>& matrix) {
-  Matrix<T, N, N> matrix_transposed =  GetTransposed(matrix);
-  matrix = matrix_transposed;
+constexpr void Transpose(Matrix<T, N, N>& matrix) {
+  if constexpr (N <= matrix_kernels::kSmallMatrixSize) {
+    matrix_kernels::SmallTransposeInPlace(matrix.inner_matrix_, std::make_index_sequence<N * N>{});
+  } else {
+    matrix_kernels::TransposeInPlace(matrix.inner_matrix_[0], N, N);
+  }
 }
 
-
 template <class T, size_t N>
 Matrix<T, N, N> GetInversed(const Matrix<T, N, N>& matrix) {
-  T matrix_det = Determinant(matrix);
-  if (matrix_det == T()) {
-    throw MatrixIsDegenerateError{};
-  }
+  if constexpr (kUseLuDecomposition<T, N>) {
+    Matrix<T, N, N> identity_matrix{};
+    for (size_t i = 0u; i < N; ++i) {
+      identity_matrix.inner_matrix_[i][i] = T(1);
+    }
+    return Solve(matrix, identity_matrix);
+  } else {
+    T matrix_det = Determinant(matrix);
+    if (matrix_det == T()) {
+      throw MatrixIsDegenerateError{};
+    }
 
-  Matrix<T, N, N> invesed_matrix;
-  for (size_t i = 0u; i < N; ++i) {
-    for (size_t j = 0u; j < N; ++j) {
-      int32_t sign = ((i + j) % 2 == 0 ? 1 : -1);
-      T cur_det = Determinant(matrix.TrimMatrix(i, j));
-      invesed_matrix.inner_matrix_[i][j] = sign * cur_det;
+    Matrix<T, N, N> invesed_matrix;
+    for (size_t i = 0u; i < N; ++i) {
+      for (size_t j = 0u; j < N; ++j) {
+        int32_t sign = ((i + j) % 2 == 0 ? 1 : -1);
+        T cur_det = Determinant(matrix.TrimMatrix(i, j));
+        invesed_matrix.inner_matrix_[i][j] = sign * cur_det;
+      }
     }
-  }
 
-  Transpose(invesed_matrix);
-  return invesed_matrix / matrix_det;
+    Transpose(invesed_matrix);
+    return invesed_matrix / matrix_det;
+  }
 }
 
 template <class T>
@@ -316,10 +444,88 @@ Matrix<T, 1, 1> GetInversed(const Matrix<T, 1, 1>& matrix) {
   return inversed_matrix;
 }
 
+template <class T>
+constexpr Matrix<T, 2, 2> GetInversed(const Matrix<T, 2, 2>& matrix) {
+  const T matrix_det = Determinant(matrix);
+  if (matrix_det == T()) {
+    throw MatrixIsDegenerateError{};
+  }
+  const auto& a = matrix.inner_matrix_;
+  return {a[1][1] / matrix_det, -a[0][1] / matrix_det, -a[1][0] / matrix_det, a[0][0] / matrix_det};
+}
+
+template <class T>
+constexpr Matrix<T, 3, 3> GetInversed(const Matrix<T, 3, 3>& matrix) {
+  const T matrix_det = Determinant(matrix);
+  if (matrix_det == T()) {
+    throw MatrixIsDegenerateError{};
+  }
+  const auto& a = matrix.inner_matrix_;
+  return {(a[1][1] * a[2][2] - a[1][2] * a[2][1]) / matrix_det, (a[0][2] * a[2][1] - a[0][1] * a[2][2]) / matrix_det,
+          (a[0][1] * a[1][2] - a[0][2] * a[1][1]) / matrix_det, (a[1][2] * a[2][0] - a[1][0] * a[2][2]) / matrix_det,
+          (a[0][0] * a[2][2] - a[0][2] * a[2][0]) / matrix_det, (a[0][2] * a[1][0] - a[0][0] * a[1][2]) / matrix_det,
+          (a[1][0] * a[2][1] - a[1][1] * a[2][0]) / matrix_det, (a[0][1] * a[2][0] - a[0][0] * a[2][1]) / matrix_det,
+          (a[0][0] * a[1][1] - a[0][1] * a[1][0]) / matrix_det};
+}
+
+template <class T>
+constexpr Matrix<T, 4, 4> GetInversed(const Matrix<T, 4, 4>& matrix) {
+  const Minors4x4<T> m = GetMinors4x4(matrix);
+  const T matrix_det = m.s_[0] * m.c_[5] - m.s_[1] * m.c_[4] + m.s_[2] * m.c_[3] + m.s_[3] * m.c_[2] -
+                       m.s_[4] * m.c_[1] + m.s_[5] * m.c_[0];
+  if (matrix_det == T()) {
+    throw MatrixIsDegenerateError{};
+  }
+  const auto& a = matrix.inner_matrix_;
+  const T* s = m.s_;
+  const T* c = m.c_;
+  return {(a[1][1] * c[5] - a[1][2] * c[4] + a[1][3] * c[3]) / matrix_det,
+          (-a[0][1] * c[5] + a[0][2] * c[4] - a[0][3] * c[3]) / matrix_det,
+          (a[3][1] * s[5] - a[3][2] * s[4] + a[3][3] * s[3]) / matrix_det,
+          (-a[2][1] * s[5] + a[2][2] * s[4] - a[2][3] * s[3]) / matrix_det,
+          (-a[1][0] * c[5] + a[1][2] * c[2] - a[1][3] * c[1]) / matrix_det,
+          (a[0][0] * c[5] - a[0][2] * c[2] + a[0][3] * c[1]) / matrix_det,
+          (-a[3][0] * s[5] + a[3][2] * s[2] - a[3][3] * s[1]) / matrix_det,
+          (a[2][0] * s[5] - a[2][2] * s[2] + a[2][3] * s[1]) / matrix_det,
+          (a[1][0] * c[4] - a[1][1] * c[2] + a[1][3] * c[0]) / matrix_det,
+          (-a[0][0] * c[4] + a[0][1] * c[2] - a[0][3] * c[0]) / matrix_det,
+          (a[3][0] * s[4] - a[3][1] * s[2] + a[3][3] * s[0]) / matrix_det,
+          (-a[2][0] * s[4] + a[2][1] * s[2] - a[2][3] * s[0]) / matrix_det,
+          (-a[1][0] * c[3] + a[1][1] * c[1] - a[1][2] * c[0]) / matrix_det,
+          (a[0][0] * c[3] - a[0][1] * c[1] + a[0][2] * c[0]) / matrix_det,
+          (-a[3][0] * s[3] + a[3][1] * s[1] - a[3][2] * s[0]) / matrix_det,
+          (a[2][0] * s[3] - a[2][1] * s[1] + a[2][2] * s[0]) / matrix_det};
+}
+
+template <class T>
+void TransformVectors(const Matrix<T, 4, 4>& transform, const T* input, T* output, size_t count) {
+  matrix_kernels::TransformVectors(transform.inner_matrix_, input, output, count);
+}
+
 template <class T, size_t N>
 void Inverse(Matrix<T, N, N>& matrix) {
   Matrix<T, N, N> inversed_matrix = GetInversed(matrix);
   matrix = inversed_matrix;
 }
 
+template <class E, std::enable_if_t<kIsMatrixNode<E>, int> = 0>
+auto Determinant(const E& expression) {
+  return Determinant(expression.Evaluate());
+}
+
+template <class E, std::enable_if_t<kIsMatrixNode<E>, int> = 0>
+auto Trace(const E& expression) {
+  return Trace(expression.Evaluate());
+}
+
+template <class E, std::enable_if_t<kIsMatrixNode<E>, int> = 0>
+auto GetTransposed(const E& expression) {
+  return GetTransposed(expression.Evaluate());
+}
+
+template <class E, std::enable_if_t<kIsMatrixNode<E>, int> = 0>
+auto GetInversed(const E& expression) {
+  return GetInversed(expression.Evaluate());
+}
+
 #endif
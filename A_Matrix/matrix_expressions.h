@@ -0,0 +1,190 @@
+#ifndef LARGETASKS_MATRIX_EXPRESSIONS_H
+#define LARGETASKS_MATRIX_EXPRESSIONS_H
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+template <class T, size_t N, size_t M>
+class Matrix;
+
+struct MatrixExpressionTag {};
+
+template <class E>
+struct IsMatrix : std::false_type {};
+
+template <class T, size_t N, size_t M>
+struct IsMatrix<Matrix<T, N, M>> : std::true_type {};
+
+template <class E>
+constexpr bool kIsMatrix = IsMatrix<std::decay_t<E>>::value;
+
+template <class E>
+constexpr bool kIsMatrixNode = std::is_base_of_v<MatrixExpressionTag, std::decay_t<E>>;
+
+template <class E>
+constexpr bool kIsMatrixExpression = kIsMatrix<E> || kIsMatrixNode<E>;
+
+// Named matrices are captured by reference; nodes and temporary matrices (e.g. products) are moved into
+// the expression, so a product inside an expression is evaluated exactly once and outlives the statement.
+template <class E>
+using MatrixOperand = std::conditional_t<kIsMatrix<E> && std::is_lvalue_reference_v<E>, const std::decay_t<E>&,
+                                         std::decay_t<E>>;
+
+template <class Derived, class T, size_t N, size_t M>
+class MatrixExpression : public MatrixExpressionTag {
+ public:
+  using ValueType = T;
+  static constexpr size_t kRows = N;
+  static constexpr size_t kColumns = M;
+
+  [[nodiscard]] size_t RowsNumber() const {
+    return N;
+  }
+
+  [[nodiscard]] size_t ColumnsNumber() const {
+    return M;
+  }
+
+  void AssignTo(Matrix<T, N, M>& matrix) const {
+    const Derived& expression = static_cast<const Derived&>(*this);
+    for (size_t i = 0u; i < N; ++i) {
+      for (size_t j = 0u; j < M; ++j) {
+        matrix.inner_matrix_[i][j] = expression(i, j);
+      }
+    }
+  }
+
+  Matrix<T, N, M> Evaluate() const {
+    Matrix<T, N, M> matrix;
+    AssignTo(matrix);
+    return matrix;
+  }
+
+  operator Matrix<T, N, M>() const {  // NOLINT
+    return Evaluate();
+  }
+};
+
+template <class Operation, class L, class R>
+class MatrixBinaryExpression
+    : public MatrixExpression<MatrixBinaryExpression<Operation, L, R>, typename std::decay_t<L>::ValueType,
+                              std::decay_t<L>::kRows, std::decay_t<L>::kColumns> {
+ private:
+  L lhs_;
+  R rhs_;
+
+ public:
+  using ValueType = typename std::decay_t<L>::ValueType;
+
+  static_assert(std::decay_t<L>::kRows == std::decay_t<R>::kRows &&
+                    std::decay_t<L>::kColumns == std::decay_t<R>::kColumns,
+                "element-wise matrix operands must have the same dimensions");
+
+  template <class LArg, class RArg>
+  MatrixBinaryExpression(LArg&& lhs, RArg&& rhs) : lhs_(std::forward<LArg>(lhs)), rhs_(std::forward<RArg>(rhs)) {
+  }
+
+  ValueType operator()(size_t n, size_t m) const {
+    return static_cast<ValueType>(Operation{}(lhs_(n, m), rhs_(n, m)));
+  }
+};
+
+template <class Operation, class E, class S>
+class MatrixScalarExpression
+    : public MatrixExpression<MatrixScalarExpression<Operation, E, S>, typename std::decay_t<E>::ValueType,
+                              std::decay_t<E>::kRows, std::decay_t<E>::kColumns> {
+ private:
+  E expression_;
+  S scalar_;
+
+ public:
+  using ValueType = typename std::decay_t<E>::ValueType;
+
+  template <class EArg>
+  MatrixScalarExpression(EArg&& expression, const S& scalar)
+      : expression_(std::forward<EArg>(expression)), scalar_(scalar) {
+  }
+
+  ValueType operator()(size_t n, size_t m) const {
+    return static_cast<ValueType>(Operation{}(expression_(n, m), scalar_));
+  }
+};
+
+template <class T, size_t N, size_t M>
+const Matrix<T, N, M>& EvaluateOperand(const Matrix<T, N, M>& matrix) {
+  return matrix;
+}
+
+template <class E, std::enable_if_t<kIsMatrixNode<E>, int> = 0>
+auto EvaluateOperand(const E& expression) {
+  return expression.Evaluate();
+}
+
+template <class L, class R, std::enable_if_t<kIsMatrixExpression<L> && kIsMatrixExpression<R>, int> = 0>
+auto operator+(L&& lhs, R&& rhs) {
+  return MatrixBinaryExpression<std::plus<>, MatrixOperand<L>, MatrixOperand<R>>(std::forward<L>(lhs),
+                                                                                 std::forward<R>(rhs));
+}
+
+template <class L, class R, std::enable_if_t<kIsMatrixExpression<L> && kIsMatrixExpression<R>, int> = 0>
+auto operator-(L&& lhs, R&& rhs) {
+  return MatrixBinaryExpression<std::minus<>, MatrixOperand<L>, MatrixOperand<R>>(std::forward<L>(lhs),
+                                                                                  std::forward<R>(rhs));
+}
+
+template <class E, std::enable_if_t<kIsMatrixExpression<E>, int> = 0>
+auto operator*(E&& expression, const typename std::decay_t<E>::ValueType& num) {
+  using ValueType = typename std::decay_t<E>::ValueType;
+  return MatrixScalarExpression<std::multiplies<>, MatrixOperand<E>, ValueType>(std::forward<E>(expression), num);
+}
+
+template <class E, std::enable_if_t<kIsMatrixExpression<E>, int> = 0>
+auto operator*(const typename std::decay_t<E>::ValueType& num, E&& expression) {
+  return std::forward<E>(expression) * num;
+}
+
+template <class E, class W, std::enable_if_t<kIsMatrixExpression<E> && !kIsMatrixExpression<W>, int> = 0>
+auto operator/(E&& expression, const W& num) {
+  return MatrixScalarExpression<std::divides<>, MatrixOperand<E>, W>(std::forward<E>(expression), num);
+}
+
+// Matrix * Matrix is a member of Matrix; this overload only materializes lazy operands before the product.
+template <class L, class R,
+          std::enable_if_t<kIsMatrixExpression<L> && kIsMatrixExpression<R> && (kIsMatrixNode<L> || kIsMatrixNode<R>),
+                           int> = 0>
+auto operator*(const L& lhs, const R& rhs) {
+  return EvaluateOperand(lhs) * EvaluateOperand(rhs);
+}
+
+template <class L, class R,
+          std::enable_if_t<kIsMatrixExpression<L> && kIsMatrixExpression<R> && (kIsMatrixNode<L> || kIsMatrixNode<R>),
+                           int> = 0>
+bool operator==(const L& lhs, const R& rhs) {
+  static_assert(L::kRows == R::kRows && L::kColumns == R::kColumns,
+                "compared matrix operands must have the same dimensions");
+  for (size_t i = 0u; i < L::kRows; ++i) {
+    for (size_t j = 0u; j < L::kColumns; ++j) {
+      if (lhs(i, j) != rhs(i, j)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <class L, class R,
+          std::enable_if_t<kIsMatrixExpression<L> && kIsMatrixExpression<R> && (kIsMatrixNode<L> || kIsMatrixNode<R>),
+                           int> = 0>
+bool operator!=(const L& lhs, const R& rhs) {
+  return !(lhs == rhs);
+}
+
+template <class E, std::enable_if_t<kIsMatrixNode<E>, int> = 0>
+std::ostream& operator<<(std::ostream& os, const E& expression) {
+  return os << expression.Evaluate();
+}
+
+#endif
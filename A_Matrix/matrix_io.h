@@ -0,0 +1,322 @@
+#ifndef LARGETASKS_MATRIX_IO_H
+#define LARGETASKS_MATRIX_IO_H
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <exception>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "dyn_matrix.h"
+#include "matrix.h"
+
+class MatrixIOError : std::exception {};
+
+enum class MatrixTypeTag : uint8_t {
+  kInt8 = 1,
+  kUInt8 = 2,
+  kInt16 = 3,
+  kUInt16 = 4,
+  kInt32 = 5,
+  kUInt32 = 6,
+  kInt64 = 7,
+  kUInt64 = 8,
+  kFloat = 9,
+  kDouble = 10,
+};
+
+template <class T>
+constexpr MatrixTypeTag GetMatrixTypeTag() {
+  static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "binary matrix I/O supports numeric types only");
+  if constexpr (std::is_floating_point_v<T>) {
+    static_assert(sizeof(T) == 4 || sizeof(T) == 8, "only float and double are supported");
+    return sizeof(T) == 4 ? MatrixTypeTag::kFloat : MatrixTypeTag::kDouble;
+  } else if constexpr (std::is_signed_v<T>) {
+    return sizeof(T) == 1   ? MatrixTypeTag::kInt8
+           : sizeof(T) == 2 ? MatrixTypeTag::kInt16
+           : sizeof(T) == 4 ? MatrixTypeTag::kInt32
+                            : MatrixTypeTag::kInt64;
+  } else {
+    return sizeof(T) == 1   ? MatrixTypeTag::kUInt8
+           : sizeof(T) == 2 ? MatrixTypeTag::kUInt16
+           : sizeof(T) == 4 ? MatrixTypeTag::kUInt32
+                            : MatrixTypeTag::kUInt64;
+  }
+}
+
+constexpr char kMatrixMagic[4] = {'L', 'H', 'W', 'M'};
+constexpr uint16_t kMatrixFormatVersion = 1;
+constexpr uint8_t kLittleEndian = 1;
+constexpr uint8_t kBigEndian = 2;
+
+inline uint8_t NativeEndianness() {
+  const uint16_t probe = 1;
+  uint8_t first_byte = 0;
+  std::memcpy(&first_byte, &probe, 1);
+  return first_byte == 1 ? kLittleEndian : kBigEndian;
+}
+
+// The header fills a whole cache line so the element data of a mapped file starts 64-byte aligned.
+struct MatrixBinaryHeader {
+  char magic_[4];
+  uint16_t version_;
+  uint8_t type_tag_;
+  uint8_t element_size_;
+  uint8_t endianness_;
+  uint8_t reserved_[7];
+  uint64_t rows_;
+  uint64_t columns_;
+  uint64_t stride_;
+  uint8_t padding_[24];
+};
+
+static_assert(sizeof(MatrixBinaryHeader) == 64, "matrix binary header must stay 64 bytes");
+
+template <class T>
+MatrixBinaryHeader MakeMatrixHeader(size_t rows, size_t columns, size_t stride) {
+  MatrixBinaryHeader header{};
+  std::memcpy(header.magic_, kMatrixMagic, sizeof(kMatrixMagic));
+  header.version_ = kMatrixFormatVersion;
+  header.type_tag_ = static_cast<uint8_t>(GetMatrixTypeTag<T>());
+  header.element_size_ = sizeof(T);
+  header.endianness_ = NativeEndianness();
+  header.rows_ = rows;
+  header.columns_ = columns;
+  header.stride_ = stride;
+  return header;
+}
+
+// The header comes from untrusted bytes: its rows_ * stride_ elements, plus the header itself, must fit in a size_t
+// before anything is sized from them.
+template <class T>
+void CheckMatrixHeader(const MatrixBinaryHeader& header) {
+  if (header.stride_ != 0 && header.rows_ > (SIZE_MAX - sizeof(MatrixBinaryHeader)) / header.stride_ / sizeof(T)) {
+    throw MatrixIOError{};
+  }
+  if (std::memcmp(header.magic_, kMatrixMagic, sizeof(kMatrixMagic)) != 0 ||
+      header.version_ != kMatrixFormatVersion || header.type_tag_ != static_cast<uint8_t>(GetMatrixTypeTag<T>()) ||
+      header.element_size_ != sizeof(T) || header.stride_ < header.columns_ ||
+      (header.endianness_ != kLittleEndian && header.endianness_ != kBigEndian)) {
+    throw MatrixIOError{};
+  }
+}
+
+template <class T>
+void SwapElementBytes(T* data, size_t n) {
+  for (size_t i = 0u; i < n; ++i) {
+    unsigned char* bytes = reinterpret_cast<unsigned char*>(data + i);
+    std::reverse(bytes, bytes + sizeof(T));
+  }
+}
+
+template <class T>
+MatrixBinaryHeader ReadMatrixHeader(std::istream& is) {
+  MatrixBinaryHeader header{};
+  if (!is.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    throw MatrixIOError{};
+  }
+  // Everything after the endianness byte is stored in the writer's byte order.
+  if (header.endianness_ != NativeEndianness()) {
+    SwapElementBytes(&header.version_, 1);
+    SwapElementBytes(&header.rows_, 1);
+    SwapElementBytes(&header.columns_, 1);
+    SwapElementBytes(&header.stride_, 1);
+  }
+  CheckMatrixHeader<T>(header);
+  return header;
+}
+
+// Reads `rows` stored rows of `stride` elements into dst rows of `ldd` elements, keeping `columns` of each.
+template <class T>
+void ReadMatrixRows(std::istream& is, const MatrixBinaryHeader& header, T* dst, size_t ldd) {
+  if (header.stride_ == ldd) {
+    if (!is.read(reinterpret_cast<char*>(dst), static_cast<std::streamsize>(header.rows_ * ldd * sizeof(T)))) {
+      throw MatrixIOError{};
+    }
+  } else {
+    for (size_t i = 0u; i < header.rows_; ++i) {
+      if (!is.read(reinterpret_cast<char*>(dst + i * ldd), static_cast<std::streamsize>(header.columns_ * sizeof(T)))) {
+        throw MatrixIOError{};
+      }
+      is.ignore(static_cast<std::streamsize>((header.stride_ - header.columns_) * sizeof(T)));
+    }
+  }
+  if (header.endianness_ != NativeEndianness()) {
+    for (size_t i = 0u; i < header.rows_; ++i) {
+      SwapElementBytes(dst + i * ldd, header.columns_);
+    }
+  }
+}
+
+template <class T, size_t N, size_t M>
+void WriteBinary(std::ostream& os, const Matrix<T, N, M>& matrix) {
+  MatrixBinaryHeader header = MakeMatrixHeader<T>(N, M, M);
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  os.write(reinterpret_cast<const char*>(matrix.inner_matrix_[0]), static_cast<std::streamsize>(N * M * sizeof(T)));
+  if (!os) {
+    throw MatrixIOError{};
+  }
+}
+
+template <class T, size_t N, size_t M>
+void ReadBinary(std::istream& is, Matrix<T, N, M>& matrix) {
+  MatrixBinaryHeader header = ReadMatrixHeader<T>(is);
+  if (header.rows_ != N || header.columns_ != M) {
+    throw MatrixInvalidDimensions{};
+  }
+  ReadMatrixRows(is, header, matrix.inner_matrix_[0], M);
+}
+
+template <class T>
+void WriteBinary(std::ostream& os, const DynMatrix<T>& matrix) {
+  MatrixBinaryHeader header = MakeMatrixHeader<T>(matrix.RowsNumber(), matrix.ColumnsNumber(), matrix.Stride());
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  os.write(reinterpret_cast<const char*>(matrix.Data()),
+           static_cast<std::streamsize>(matrix.RowsNumber() * matrix.Stride() * sizeof(T)));
+  if (!os) {
+    throw MatrixIOError{};
+  }
+}
+
+template <class T>
+void ReadBinary(std::istream& is, DynMatrix<T>& matrix) {
+  MatrixBinaryHeader header = ReadMatrixHeader<T>(is);
+  DynMatrix<T> new_matrix(header.rows_, header.columns_, header.stride_);
+  ReadMatrixRows(is, header, new_matrix.Data(), new_matrix.Stride());
+  matrix = std::move(new_matrix);
+}
+
+// Read-only view over a file written by WriteBinary; elements are served straight from the page cache.
+template <class T>
+class MatrixView {
+ private:
+  void* mapping_ = nullptr;
+  size_t mapping_size_ = 0;
+  const T* data_ = nullptr;
+  size_t rows_ = 0;
+  size_t columns_ = 0;
+  size_t stride_ = 0;
+
+  void Unmap() noexcept {
+    if (mapping_ != nullptr) {
+      munmap(mapping_, mapping_size_);
+    }
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    data_ = nullptr;
+    rows_ = 0;
+    columns_ = 0;
+    stride_ = 0;
+  }
+
+ public:
+  MatrixView() noexcept = default;
+
+  explicit MatrixView(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw MatrixIOError{};
+    }
+    struct stat file_stat {};
+    if (fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < sizeof(MatrixBinaryHeader)) {
+      close(fd);
+      throw MatrixIOError{};
+    }
+    size_t size = static_cast<size_t>(file_stat.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+      throw MatrixIOError{};
+    }
+
+    const auto* header = static_cast<const MatrixBinaryHeader*>(mapping);
+    try {
+      if (header->endianness_ != NativeEndianness()) {
+        throw MatrixIOError{};
+      }
+      CheckMatrixHeader<T>(*header);
+      if (size < sizeof(MatrixBinaryHeader) + header->rows_ * header->stride_ * sizeof(T)) {
+        throw MatrixIOError{};
+      }
+    } catch (...) {
+      munmap(mapping, size);
+      throw;
+    }
+    mapping_ = mapping;
+    mapping_size_ = size;
+    data_ = reinterpret_cast<const T*>(static_cast<const char*>(mapping) + sizeof(MatrixBinaryHeader));
+    rows_ = header->rows_;
+    columns_ = header->columns_;
+    stride_ = header->stride_;
+  }
+
+  MatrixView(const MatrixView<T>&) = delete;
+  MatrixView<T>& operator=(const MatrixView<T>&) = delete;
+
+  MatrixView(MatrixView<T>&& rvalue_view) noexcept {
+    Swap(rvalue_view);
+  }
+
+  MatrixView<T>& operator=(MatrixView<T>&& rvalue_view) noexcept {
+    if (this != &rvalue_view) {
+      Unmap();
+      Swap(rvalue_view);
+    }
+    return *this;
+  }
+
+  void Swap(MatrixView<T>& other) noexcept {
+    std::swap(mapping_, other.mapping_);
+    std::swap(mapping_size_, other.mapping_size_);
+    std::swap(data_, other.data_);
+    std::swap(rows_, other.rows_);
+    std::swap(columns_, other.columns_);
+    std::swap(stride_, other.stride_);
+  }
+
+  [[nodiscard]] size_t RowsNumber() const noexcept {
+    return rows_;
+  }
+
+  [[nodiscard]] size_t ColumnsNumber() const noexcept {
+    return columns_;
+  }
+
+  [[nodiscard]] size_t Stride() const noexcept {
+    return stride_;
+  }
+
+  const T* Data() const noexcept {
+    return data_;
+  }
+
+  const T* Row(size_t n) const noexcept {
+    return data_ + n * stride_;
+  }
+
+  const T& operator()(size_t n, size_t m) const {
+    return data_[n * stride_ + m];
+  }
+
+  const T& At(size_t n, size_t m) const {
+    if (n >= rows_ || m >= columns_) {
+      throw MatrixOutOfRange();
+    }
+    return data_[n * stride_ + m];
+  }
+
+  ~MatrixView() {
+    Unmap();
+  }
+};
+
+#endif
@@ -0,0 +1,690 @@
+#ifndef LARGETASKS_MATRIX_KERNELS_H
+#define LARGETASKS_MATRIX_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__) || defined(__AVX512F__) || defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+namespace matrix_kernels {
+
+// c[rows x cols] = a[rows x depth] * b[depth x cols], all operands addressed through row strides.
+constexpr size_t kRowBlock = 64;
+constexpr size_t kDepthBlock = 256;
+constexpr size_t kColumnBlock = 512;
+constexpr size_t kRegisterRows = 4;
+constexpr size_t kRegisterVectors = 2;
+constexpr size_t kBlockedThreshold = 32u * 32u * 32u;
+
+template <class T>
+constexpr bool kHasBlockedKernel =
+    std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, int32_t>;
+
+template <class T>
+struct SimdTraits {
+  static constexpr size_t kWidth = 0;
+};
+
+#if defined(__AVX512F__)
+template <>
+struct SimdTraits<float> {
+  using Register = __m512;
+  static constexpr size_t kWidth = 16;
+  static Register Load(const float* ptr) {
+    return _mm512_loadu_ps(ptr);
+  }
+  static void Store(float* ptr, Register value) {
+    _mm512_storeu_ps(ptr, value);
+  }
+  static Register Broadcast(float value) {
+    return _mm512_set1_ps(value);
+  }
+  static Register MulAdd(Register lhs, Register rhs, Register acc) {
+    return _mm512_fmadd_ps(lhs, rhs, acc);
+  }
+};
+
+template <>
+struct SimdTraits<double> {
+  using Register = __m512d;
+  static constexpr size_t kWidth = 8;
+  static Register Load(const double* ptr) {
+    return _mm512_loadu_pd(ptr);
+  }
+  static void Store(double* ptr, Register value) {
+    _mm512_storeu_pd(ptr, value);
+  }
+  static Register Broadcast(double value) {
+    return _mm512_set1_pd(value);
+  }
+  static Register MulAdd(Register lhs, Register rhs, Register acc) {
+    return _mm512_fmadd_pd(lhs, rhs, acc);
+  }
+};
+
+template <>
+struct SimdTraits<int32_t> {
+  using Register = __m512i;
+  static constexpr size_t kWidth = 16;
+  static Register Load(const int32_t* ptr) {
+    return _mm512_loadu_si512(ptr);
+  }
+  static void Store(int32_t* ptr, Register value) {
+    _mm512_storeu_si512(ptr, value);
+  }
+  static Register Broadcast(int32_t value) {
+    return _mm512_set1_epi32(value);
+  }
+  static Register MulAdd(Register lhs, Register rhs, Register acc) {
+    return _mm512_add_epi32(_mm512_mullo_epi32(lhs, rhs), acc);
+  }
+};
+#elif defined(__AVX2__)
+template <>
+struct SimdTraits<float> {
+  using Register = __m256;
+  static constexpr size_t kWidth = 8;
+  static Register Load(const float* ptr) {
+    return _mm256_loadu_ps(ptr);
+  }
+  static void Store(float* ptr, Register value) {
+    _mm256_storeu_ps(ptr, value);
+  }
+  static Register Broadcast(float value) {
+    return _mm256_set1_ps(value);
+  }
+  static Register MulAdd(Register lhs, Register rhs, Register acc) {
+#if defined(__FMA__)
+    return _mm256_fmadd_ps(lhs, rhs, acc);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(lhs, rhs), acc);
+#endif
+  }
+};
+
+template <>
+struct SimdTraits<double> {
+  using Register = __m256d;
+  static constexpr size_t kWidth = 4;
+  static Register Load(const double* ptr) {
+    return _mm256_loadu_pd(ptr);
+  }
+  static void Store(double* ptr, Register value) {
+    _mm256_storeu_pd(ptr, value);
+  }
+  static Register Broadcast(double value) {
+    return _mm256_set1_pd(value);
+  }
+  static Register MulAdd(Register lhs, Register rhs, Register acc) {
+#if defined(__FMA__)
+    return _mm256_fmadd_pd(lhs, rhs, acc);
+#else
+    return _mm256_add_pd(_mm256_mul_pd(lhs, rhs), acc);
+#endif
+  }
+};
+
+template <>
+struct SimdTraits<int32_t> {
+  using Register = __m256i;
+  static constexpr size_t kWidth = 8;
+  static Register Load(const int32_t* ptr) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+  }
+  static void Store(int32_t* ptr, Register value) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), value);
+  }
+  static Register Broadcast(int32_t value) {
+    return _mm256_set1_epi32(value);
+  }
+  static Register MulAdd(Register lhs, Register rhs, Register acc) {
+    return _mm256_add_epi32(_mm256_mullo_epi32(lhs, rhs), acc);
+  }
+};
+#endif
+
+template <class T>
+void NaiveMultiply(const T* a, const T* b, T* c, size_t n, size_t m, size_t w, size_t lda, size_t ldb,
+                   size_t ldc) {
+  for (size_t i = 0u; i < n; ++i) {
+    for (size_t k = 0u; k < w; ++k) {
+      T nw_temp_value = T();
+      for (size_t j = 0u; j < m; ++j) {
+        nw_temp_value += a[i * lda + j] * b[j * ldb + k];
+      }
+      c[i * ldc + k] = nw_temp_value;
+    }
+  }
+}
+
+// c += a * b over one cache block, streaming rows of b so the inner loop is unit-stride.
+template <class T>
+void ScalarBlock(const T* a, const T* b, T* c, size_t rows, size_t depth, size_t cols, size_t lda, size_t ldb,
+                 size_t ldc) {
+  for (size_t i = 0u; i < rows; ++i) {
+    T* c_row = c + i * ldc;
+    for (size_t k = 0u; k < depth; ++k) {
+      const T a_value = a[i * lda + k];
+      const T* b_row = b + k * ldb;
+      for (size_t j = 0u; j < cols; ++j) {
+        c_row[j] += a_value * b_row[j];
+      }
+    }
+  }
+}
+
+// kRegisterRows x (kRegisterVectors * kWidth) tile of c kept in registers for the whole depth.
+template <class T>
+void MicroKernel(const T* a, const T* b, T* c, size_t depth, size_t lda, size_t ldb, size_t ldc) {
+  using Traits = SimdTraits<T>;
+  using Register = typename Traits::Register;
+  constexpr size_t kWidth = Traits::kWidth;
+
+  Register acc[kRegisterRows][kRegisterVectors];
+  for (size_t r = 0u; r < kRegisterRows; ++r) {
+    for (size_t v = 0u; v < kRegisterVectors; ++v) {
+      acc[r][v] = Traits::Load(c + r * ldc + v * kWidth);
+    }
+  }
+  for (size_t k = 0u; k < depth; ++k) {
+    Register b_row[kRegisterVectors];
+    for (size_t v = 0u; v < kRegisterVectors; ++v) {
+      b_row[v] = Traits::Load(b + k * ldb + v * kWidth);
+    }
+    for (size_t r = 0u; r < kRegisterRows; ++r) {
+      Register a_value = Traits::Broadcast(a[r * lda + k]);
+      for (size_t v = 0u; v < kRegisterVectors; ++v) {
+        acc[r][v] = Traits::MulAdd(a_value, b_row[v], acc[r][v]);
+      }
+    }
+  }
+  for (size_t r = 0u; r < kRegisterRows; ++r) {
+    for (size_t v = 0u; v < kRegisterVectors; ++v) {
+      Traits::Store(c + r * ldc + v * kWidth, acc[r][v]);
+    }
+  }
+}
+
+template <class T>
+void MultiplyBlock(const T* a, const T* b, T* c, size_t rows, size_t depth, size_t cols, size_t lda, size_t ldb,
+                   size_t ldc) {
+  size_t i = 0u;
+  if constexpr (SimdTraits<T>::kWidth != 0) {
+    constexpr size_t kTileColumns = SimdTraits<T>::kWidth * kRegisterVectors;
+    for (; i + kRegisterRows <= rows; i += kRegisterRows) {
+      size_t j = 0u;
+      for (; j + kTileColumns <= cols; j += kTileColumns) {
+        MicroKernel(a + i * lda, b + j, c + i * ldc + j, depth, lda, ldb, ldc);
+      }
+      if (j < cols) {
+        ScalarBlock(a + i * lda, b + j, c + i * ldc + j, kRegisterRows, depth, cols - j, lda, ldb, ldc);
+      }
+    }
+  }
+  if (i < rows) {
+    ScalarBlock(a + i * lda, b, c + i * ldc, rows - i, depth, cols, lda, ldb, ldc);
+  }
+}
+
+template <class T>
+void BlockedMultiply(const T* a, const T* b, T* c, size_t n, size_t m, size_t w, size_t lda, size_t ldb,
+                     size_t ldc) {
+  for (size_t i = 0u; i < n; ++i) {
+    std::fill_n(c + i * ldc, w, T());
+  }
+  for (size_t kk = 0u; kk < m; kk += kDepthBlock) {
+    size_t depth = std::min(kDepthBlock, m - kk);
+    for (size_t jj = 0u; jj < w; jj += kColumnBlock) {
+      size_t cols = std::min(kColumnBlock, w - jj);
+      for (size_t ii = 0u; ii < n; ii += kRowBlock) {
+        size_t rows = std::min(kRowBlock, n - ii);
+        MultiplyBlock(a + ii * lda + kk, b + kk * ldb + jj, c + ii * ldc + jj, rows, depth, cols, lda, ldb, ldc);
+      }
+    }
+  }
+}
+
+// The size check folds away for fixed-size matrices, so the kernel is effectively picked from T and N, M, W.
+template <class T>
+void ClassicMultiply(const T* a, const T* b, T* c, size_t n, size_t m, size_t w, size_t lda, size_t ldb,
+                     size_t ldc) {
+  if constexpr (kHasBlockedKernel<T>) {
+    if (n * m * w >= kBlockedThreshold) {
+      BlockedMultiply(a, b, c, n, m, w, lda, ldb, ldc);
+      return;
+    }
+  }
+  NaiveMultiply(a, b, c, n, m, w, lda, ldb, ldc);
+}
+
+// Strassen-Winograd reorders and cancels floating-point rounding differently from the classic product; build with
+// MATRIX_DISABLE_STRASSEN where results must be bit-for-bit reproducible.
+#if defined(MATRIX_DISABLE_STRASSEN)
+constexpr bool kStrassenEnabled = false;
+#else
+constexpr bool kStrassenEnabled = true;
+#endif
+
+constexpr size_t kStrassenThreshold = 1024;
+constexpr size_t kStrassenCutoff = 256;
+
+template <class T>
+constexpr bool kHasStrassen = kStrassenEnabled && std::is_floating_point_v<T>;
+
+template <class T>
+class ScratchArena {
+ private:
+  std::unique_ptr<T[]> buffer_;
+  size_t used_ = 0;
+
+ public:
+  explicit ScratchArena(size_t size) : buffer_(new T[size]) {
+  }
+
+  T* Allocate(size_t n) {
+    T* block = buffer_.get() + used_;
+    used_ += n;
+    return block;
+  }
+
+  [[nodiscard]] size_t Mark() const {
+    return used_;
+  }
+
+  void Release(size_t mark) {
+    used_ = mark;
+  }
+};
+
+// Each recursion level holds four half-size temporaries while its sub-products run.
+inline size_t StrassenScratchSize(size_t n) {
+  size_t size = 0u;
+  while (n > kStrassenCutoff && n % 2 == 0) {
+    n /= 2;
+    size += 4 * n * n;
+  }
+  return size;
+}
+
+template <class T, class Operation>
+void CombineBlocks(T* dst, size_t ldd, const T* x, size_t ldx, const T* y, size_t ldy, size_t n, Operation op) {
+  for (size_t i = 0u; i < n; ++i) {
+    for (size_t j = 0u; j < n; ++j) {
+      dst[i * ldd + j] = op(x[i * ldx + j], y[i * ldy + j]);
+    }
+  }
+}
+
+template <class T>
+void StrassenMultiply(const T* a, const T* b, T* c, size_t n, size_t lda, size_t ldb, size_t ldc,
+                      ScratchArena<T>& arena) {
+  if (n <= kStrassenCutoff || n % 2 != 0) {
+    ClassicMultiply(a, b, c, n, n, n, lda, ldb, ldc);
+    return;
+  }
+  auto plus = [](const T& x, const T& y) { return x + y; };
+  auto minus = [](const T& x, const T& y) { return x - y; };
+
+  size_t h = n / 2;
+  const T* a11 = a;
+  const T* a12 = a + h;
+  const T* a21 = a + h * lda;
+  const T* a22 = a + h * lda + h;
+  const T* b11 = b;
+  const T* b12 = b + h;
+  const T* b21 = b + h * ldb;
+  const T* b22 = b + h * ldb + h;
+  T* c11 = c;
+  T* c12 = c + h;
+  T* c21 = c + h * ldc;
+  T* c22 = c + h * ldc + h;
+
+  size_t mark = arena.Mark();
+  T* s = arena.Allocate(h * h);
+  T* t = arena.Allocate(h * h);
+  T* x = arena.Allocate(h * h);
+  T* y = arena.Allocate(h * h);
+
+  CombineBlocks(s, h, a21, lda, a22, lda, h, plus);
+  CombineBlocks(t, h, b12, ldb, b11, ldb, h, minus);
+  StrassenMultiply(s, t, c22, h, h, h, ldc, arena);
+  CombineBlocks(s, h, s, h, a11, lda, h, minus);
+  CombineBlocks(t, h, b22, ldb, t, h, h, minus);
+  StrassenMultiply(s, t, x, h, h, h, h, arena);
+  CombineBlocks(s, h, a12, lda, s, h, h, minus);
+  StrassenMultiply(s, b22, c12, h, h, ldb, ldc, arena);
+  CombineBlocks(t, h, t, h, b21, ldb, h, minus);
+  StrassenMultiply(a22, t, c21, h, lda, h, ldc, arena);
+  StrassenMultiply(a11, b11, y, h, lda, ldb, h, arena);
+  CombineBlocks(x, h, x, h, y, h, h, plus);
+  StrassenMultiply(a12, b21, c11, h, lda, ldb, ldc, arena);
+  CombineBlocks(c11, ldc, c11, ldc, y, h, h, plus);
+  CombineBlocks(s, h, a11, lda, a21, lda, h, minus);
+  CombineBlocks(t, h, b22, ldb, b12, ldb, h, minus);
+  StrassenMultiply(s, t, y, h, h, h, h, arena);
+  CombineBlocks(c12, ldc, c12, ldc, c22, ldc, h, plus);
+  CombineBlocks(c12, ldc, c12, ldc, x, h, h, plus);
+  CombineBlocks(x, h, x, h, y, h, h, plus);
+  CombineBlocks(c21, ldc, x, h, c21, ldc, h, minus);
+  CombineBlocks(c22, ldc, x, h, c22, ldc, h, plus);
+
+  arena.Release(mark);
+}
+
+template <class T>
+void Multiply(const T* a, const T* b, T* c, size_t n, size_t m, size_t w, size_t lda, size_t ldb, size_t ldc) {
+  if constexpr (kHasStrassen<T>) {
+    if (n == m && m == w && n >= kStrassenThreshold) {
+      ScratchArena<T> arena(StrassenScratchSize(n));
+      StrassenMultiply(a, b, c, n, lda, ldb, ldc, arena);
+      return;
+    }
+  }
+  ClassicMultiply(a, b, c, n, m, w, lda, ldb, ldc);
+}
+
+// a[n x m] *= b[m x m] without a full-size temporary: each result row only reads the same row of a,
+// so rows are copied out in bands of roughly kBandBytes before being overwritten. Every band reads all of b,
+// so a b that overlaps a (as in m *= m) is copied out first.
+constexpr size_t kBandBytes = 16384;
+
+template <class T, size_t N, size_t M>
+void MultiplyInPlace(T* a, const T* b) {
+  constexpr size_t kBandRows = std::clamp<size_t>(kBandBytes / (M * sizeof(T)), 1u, N);
+  std::unique_ptr<T[]> b_copy;
+  std::less<const T*> before;
+  if (before(b, a + N * M) && before(a, b + M * M)) {
+    b_copy = std::make_unique<T[]>(M * M);
+    std::copy(b, b + M * M, b_copy.get());
+    b = b_copy.get();
+  }
+  T band[kBandRows][M];
+  for (size_t i = 0u; i < N; i += kBandRows) {
+    size_t rows = std::min(kBandRows, N - i);
+    std::copy(a + i * M, a + (i + rows) * M, band[0]);
+    ClassicMultiply(band[0], b, a + i * M, rows, M, M, M, M, M);
+  }
+}
+
+// Transposition walks kTransposeBlock-wide cache blocks made of kTransposeTile x kTransposeTile register tiles.
+constexpr size_t kTransposeTile = 4;
+constexpr size_t kTransposeBlock = 32;
+constexpr size_t kTransposeLeafElements = 256;
+
+// Stores the transpose of tile a over tile b and vice versa; a == b transposes a single tile in place.
+template <class T>
+void SwapTransposedTiles(T* a, T* b, size_t ld) {
+#if defined(__SSE__)
+  if constexpr (std::is_same_v<T, float>) {
+    __m128 a0 = _mm_loadu_ps(a);
+    __m128 a1 = _mm_loadu_ps(a + ld);
+    __m128 a2 = _mm_loadu_ps(a + 2 * ld);
+    __m128 a3 = _mm_loadu_ps(a + 3 * ld);
+    __m128 b0 = _mm_loadu_ps(b);
+    __m128 b1 = _mm_loadu_ps(b + ld);
+    __m128 b2 = _mm_loadu_ps(b + 2 * ld);
+    __m128 b3 = _mm_loadu_ps(b + 3 * ld);
+    _MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+    _MM_TRANSPOSE4_PS(b0, b1, b2, b3);
+    _mm_storeu_ps(b, a0);
+    _mm_storeu_ps(b + ld, a1);
+    _mm_storeu_ps(b + 2 * ld, a2);
+    _mm_storeu_ps(b + 3 * ld, a3);
+    _mm_storeu_ps(a, b0);
+    _mm_storeu_ps(a + ld, b1);
+    _mm_storeu_ps(a + 2 * ld, b2);
+    _mm_storeu_ps(a + 3 * ld, b3);
+    return;
+  }
+#endif
+#if defined(__AVX__)
+  if constexpr (std::is_same_v<T, double>) {
+    auto transpose = [](__m256d& r0, __m256d& r1, __m256d& r2, __m256d& r3) {
+      __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+      __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+      __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+      __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+      r0 = _mm256_permute2f128_pd(t0, t2, 0x20);
+      r1 = _mm256_permute2f128_pd(t1, t3, 0x20);
+      r2 = _mm256_permute2f128_pd(t0, t2, 0x31);
+      r3 = _mm256_permute2f128_pd(t1, t3, 0x31);
+    };
+    __m256d a0 = _mm256_loadu_pd(a);
+    __m256d a1 = _mm256_loadu_pd(a + ld);
+    __m256d a2 = _mm256_loadu_pd(a + 2 * ld);
+    __m256d a3 = _mm256_loadu_pd(a + 3 * ld);
+    __m256d b0 = _mm256_loadu_pd(b);
+    __m256d b1 = _mm256_loadu_pd(b + ld);
+    __m256d b2 = _mm256_loadu_pd(b + 2 * ld);
+    __m256d b3 = _mm256_loadu_pd(b + 3 * ld);
+    transpose(a0, a1, a2, a3);
+    transpose(b0, b1, b2, b3);
+    _mm256_storeu_pd(b, a0);
+    _mm256_storeu_pd(b + ld, a1);
+    _mm256_storeu_pd(b + 2 * ld, a2);
+    _mm256_storeu_pd(b + 3 * ld, a3);
+    _mm256_storeu_pd(a, b0);
+    _mm256_storeu_pd(a + ld, b1);
+    _mm256_storeu_pd(a + 2 * ld, b2);
+    _mm256_storeu_pd(a + 3 * ld, b3);
+    return;
+  }
+#endif
+  if (a == b) {
+    for (size_t r = 0u; r < kTransposeTile; ++r) {
+      for (size_t c = r + 1; c < kTransposeTile; ++c) {
+        std::swap(a[r * ld + c], a[c * ld + r]);
+      }
+    }
+    return;
+  }
+  for (size_t r = 0u; r < kTransposeTile; ++r) {
+    for (size_t c = 0u; c < kTransposeTile; ++c) {
+      std::swap(a[r * ld + c], b[c * ld + r]);
+    }
+  }
+}
+
+// Stores the transpose of the tile at src (row stride lds) into the tile at dst (row stride ldd).
+template <class T>
+void CopyTransposedTile(const T* src, T* dst, size_t lds, size_t ldd) {
+#if defined(__SSE__)
+  if constexpr (std::is_same_v<T, float>) {
+    __m128 r0 = _mm_loadu_ps(src);
+    __m128 r1 = _mm_loadu_ps(src + lds);
+    __m128 r2 = _mm_loadu_ps(src + 2 * lds);
+    __m128 r3 = _mm_loadu_ps(src + 3 * lds);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(dst, r0);
+    _mm_storeu_ps(dst + ldd, r1);
+    _mm_storeu_ps(dst + 2 * ldd, r2);
+    _mm_storeu_ps(dst + 3 * ldd, r3);
+    return;
+  }
+#endif
+#if defined(__AVX__)
+  if constexpr (std::is_same_v<T, double>) {
+    __m256d r0 = _mm256_loadu_pd(src);
+    __m256d r1 = _mm256_loadu_pd(src + lds);
+    __m256d r2 = _mm256_loadu_pd(src + 2 * lds);
+    __m256d r3 = _mm256_loadu_pd(src + 3 * lds);
+    __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+    __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+    __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+    __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+    _mm256_storeu_pd(dst, _mm256_permute2f128_pd(t0, t2, 0x20));
+    _mm256_storeu_pd(dst + ldd, _mm256_permute2f128_pd(t1, t3, 0x20));
+    _mm256_storeu_pd(dst + 2 * ldd, _mm256_permute2f128_pd(t0, t2, 0x31));
+    _mm256_storeu_pd(dst + 3 * ldd, _mm256_permute2f128_pd(t1, t3, 0x31));
+    return;
+  }
+#endif
+  for (size_t r = 0u; r < kTransposeTile; ++r) {
+    for (size_t c = 0u; c < kTransposeTile; ++c) {
+      dst[c * ldd + r] = src[r * lds + c];
+    }
+  }
+}
+
+template <class T>
+void TransposeInPlace(T* data, size_t n, size_t ld) {
+  size_t tiled = n - n % kTransposeTile;
+  for (size_t ii = 0u; ii < tiled; ii += kTransposeBlock) {
+    size_t i_end = std::min(ii + kTransposeBlock, tiled);
+    for (size_t jj = ii; jj < tiled; jj += kTransposeBlock) {
+      size_t j_end = std::min(jj + kTransposeBlock, tiled);
+      for (size_t i = ii; i < i_end; i += kTransposeTile) {
+        for (size_t j = (ii == jj ? i : jj); j < j_end; j += kTransposeTile) {
+          SwapTransposedTiles(data + i * ld + j, data + j * ld + i, ld);
+        }
+      }
+    }
+  }
+  for (size_t i = 0u; i < n; ++i) {
+    for (size_t j = std::max(tiled, i + 1); j < n; ++j) {
+      std::swap(data[i * ld + j], data[j * ld + i]);
+    }
+  }
+}
+
+// Cache-oblivious: halves the longer side until a block fits comfortably in L1, whatever the cache sizes.
+template <class T>
+void TransposeCopy(const T* src, T* dst, size_t rows, size_t cols, size_t lds, size_t ldd) {
+  if (rows * cols <= kTransposeLeafElements) {
+    size_t tiled_rows = rows - rows % kTransposeTile;
+    size_t tiled_cols = cols - cols % kTransposeTile;
+    for (size_t i = 0u; i < tiled_rows; i += kTransposeTile) {
+      for (size_t j = 0u; j < tiled_cols; j += kTransposeTile) {
+        CopyTransposedTile(src + i * lds + j, dst + j * ldd + i, lds, ldd);
+      }
+    }
+    for (size_t i = 0u; i < rows; ++i) {
+      for (size_t j = (i < tiled_rows ? tiled_cols : 0u); j < cols; ++j) {
+        dst[j * ldd + i] = src[i * lds + j];
+      }
+    }
+    return;
+  }
+  if (rows >= cols) {
+    size_t half = rows / 2;
+    TransposeCopy(src, dst, half, cols, lds, ldd);
+    TransposeCopy(src + half * lds, dst + half, rows - half, cols, lds, ldd);
+  } else {
+    size_t half = cols / 2;
+    TransposeCopy(src, dst, rows, half, lds, ldd);
+    TransposeCopy(src + half, dst + half * ldd, rows, cols - half, lds, ldd);
+  }
+}
+
+// Matrices up to kSmallMatrixSize on each side are fully unrolled at compile time and stay constexpr-evaluable.
+constexpr size_t kSmallMatrixSize = 4;
+
+template <size_t N, size_t M, size_t W>
+constexpr bool kIsSmallProduct = N <= kSmallMatrixSize && M <= kSmallMatrixSize && W <= kSmallMatrixSize;
+
+constexpr bool IsConstantEvaluated() {
+#if defined(__cpp_lib_is_constant_evaluated)
+  return std::is_constant_evaluated();
+#elif defined(__GNUC__)
+  return __builtin_is_constant_evaluated();
+#else
+  return true;
+#endif
+}
+
+template <class T>
+constexpr void SwapValues(T& lhs, T& rhs) {
+  T tmp = lhs;
+  lhs = rhs;
+  rhs = tmp;
+}
+
+template <class T, size_t M, size_t M1, size_t W, size_t... Ks>
+constexpr T SmallDot(const T (&row)[M], const T (&b)[M1][W], size_t j, std::index_sequence<Ks...>) {
+  return (T() + ... + (row[Ks] * b[Ks][j]));
+}
+
+template <class T, size_t N, size_t M, size_t M1, size_t W, size_t... Is>
+constexpr void SmallMultiply(const T (&a)[N][M], const T (&b)[M1][W], T (&c)[N][W], std::index_sequence<Is...>) {
+  ((c[Is / W][Is % W] = SmallDot(a[Is / W], b, Is % W, std::make_index_sequence<M>{})), ...);
+}
+
+#if defined(__SSE__)
+inline void Sse4x4Multiply(const float* a, const float* b, float* c) {
+  __m128 b0 = _mm_loadu_ps(b);
+  __m128 b1 = _mm_loadu_ps(b + 4);
+  __m128 b2 = _mm_loadu_ps(b + 8);
+  __m128 b3 = _mm_loadu_ps(b + 12);
+  for (size_t i = 0u; i < 4; ++i) {
+    __m128 row = _mm_mul_ps(_mm_set1_ps(a[i * 4]), b0);
+    row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i * 4 + 1]), b1));
+    row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i * 4 + 2]), b2));
+    row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i * 4 + 3]), b3));
+    _mm_storeu_ps(c + i * 4, row);
+  }
+}
+#endif
+
+template <class T, size_t N, size_t M, size_t M1, size_t W>
+constexpr void SmallMultiply(const T (&a)[N][M], const T (&b)[M1][W], T (&c)[N][W]) {
+#if defined(__SSE__)
+  if constexpr (std::is_same_v<T, float> && N == 4 && M == 4 && M1 == 4 && W == 4) {
+    if (!IsConstantEvaluated()) {
+      Sse4x4Multiply(a[0], b[0], c[0]);
+      return;
+    }
+  }
+#endif
+  SmallMultiply(a, b, c, std::make_index_sequence<N * W>{});
+}
+
+template <class T, size_t N, size_t... Is>
+constexpr void SmallTransposeInPlace(T (&a)[N][N], std::index_sequence<Is...>) {
+  ((Is / N < Is % N ? SwapValues(a[Is / N][Is % N], a[Is % N][Is / N]) : void()), ...);
+}
+
+template <class T, size_t N, size_t M, size_t... Is>
+constexpr void SmallTransposeCopy(const T (&src)[N][M], T (&dst)[M][N], std::index_sequence<Is...>) {
+  ((dst[Is % M][Is / M] = src[Is / M][Is % M]), ...);
+}
+
+// Applies a 4x4 transform to `count` packed 4-component column vectors; input and output may alias.
+template <class T>
+void TransformVectors(const T (&m)[4][4], const T* input, T* output, size_t count) {
+#if defined(__SSE__)
+  if constexpr (std::is_same_v<T, float>) {
+    __m128 c0 = _mm_setr_ps(m[0][0], m[1][0], m[2][0], m[3][0]);
+    __m128 c1 = _mm_setr_ps(m[0][1], m[1][1], m[2][1], m[3][1]);
+    __m128 c2 = _mm_setr_ps(m[0][2], m[1][2], m[2][2], m[3][2]);
+    __m128 c3 = _mm_setr_ps(m[0][3], m[1][3], m[2][3], m[3][3]);
+    for (size_t v = 0u; v < count; ++v) {
+      const float* in = input + v * 4;
+      __m128 result = _mm_mul_ps(c0, _mm_set1_ps(in[0]));
+      result = _mm_add_ps(result, _mm_mul_ps(c1, _mm_set1_ps(in[1])));
+      result = _mm_add_ps(result, _mm_mul_ps(c2, _mm_set1_ps(in[2])));
+      result = _mm_add_ps(result, _mm_mul_ps(c3, _mm_set1_ps(in[3])));
+      _mm_storeu_ps(output + v * 4, result);
+    }
+    return;
+  }
+#endif
+  for (size_t v = 0u; v < count; ++v) {
+    const T in[4] = {input[v * 4], input[v * 4 + 1], input[v * 4 + 2], input[v * 4 + 3]};
+    for (size_t i = 0u; i < 4; ++i) {
+      output[v * 4 + i] = m[i][0] * in[0] + m[i][1] * in[1] + m[i][2] * in[2] + m[i][3] * in[3];
+    }
+  }
+}
+
+}  // namespace matrix_kernels
+
+#endif
@@ -0,0 +1,204 @@
+#ifndef LARGETASKS_MATRIX_PARALLEL_H
+#define LARGETASKS_MATRIX_PARALLEL_H
+
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include "dyn_matrix.h"
+#include "matrix.h"
+#include "matrix_kernels.h"
+#include "thread_pool.h"
+
+namespace matrix_execution {
+
+struct SequencedPolicy {};
+struct ParallelPolicy {};
+
+inline constexpr SequencedPolicy seq{};
+inline constexpr ParallelPolicy par{};
+
+template <class Policy>
+constexpr bool kIsExecutionPolicy = std::is_same_v<std::decay_t<Policy>, SequencedPolicy> ||
+                                    std::is_same_v<std::decay_t<Policy>, ParallelPolicy>;
+
+}  // namespace matrix_execution
+
+// Below these sizes a parallel call runs serially: splitting would cost more than the work itself.
+constexpr size_t kParallelMultiplyThreshold = 96u * 96u * 96u;
+constexpr size_t kParallelElementThreshold = 1u << 16;
+constexpr size_t kParallelRowTile = 64;
+constexpr size_t kParallelColumnTile = 256;
+constexpr size_t kParallelBandElements = 1u << 14;
+
+namespace matrix_kernels {
+
+template <class T>
+void ParallelMultiply(const T* a, const T* b, T* c, size_t n, size_t m, size_t w, size_t lda, size_t ldb,
+                      size_t ldc) {
+  if (n * m * w < kParallelMultiplyThreshold) {
+    ClassicMultiply(a, b, c, n, m, w, lda, ldb, ldc);
+    return;
+  }
+  size_t row_tiles = (n + kParallelRowTile - 1) / kParallelRowTile;
+  size_t column_tiles = (w + kParallelColumnTile - 1) / kParallelColumnTile;
+  DefaultThreadPool().ParallelFor(0u, row_tiles * column_tiles, 1u, [&](size_t tile_begin, size_t tile_end) {
+    for (size_t tile = tile_begin; tile < tile_end; ++tile) {
+      size_t i = tile / column_tiles * kParallelRowTile;
+      size_t j = tile % column_tiles * kParallelColumnTile;
+      size_t rows = std::min(kParallelRowTile, n - i);
+      size_t cols = std::min(kParallelColumnTile, w - j);
+      ClassicMultiply(a + i * lda, b + j, c + i * ldc + j, rows, m, cols, lda, ldb, ldc);
+    }
+  });
+}
+
+template <class Body>
+void ParallelRowBands(size_t rows, size_t columns, const Body& body) {
+  if (rows * columns < kParallelElementThreshold) {
+    body(0u, rows);
+    return;
+  }
+  size_t grain = std::max<size_t>(1u, kParallelBandElements / std::max<size_t>(1u, columns));
+  DefaultThreadPool().ParallelFor(0u, rows, grain, body);
+}
+
+}  // namespace matrix_kernels
+
+template <class T, size_t N, size_t M, size_t M1, size_t W>
+Matrix<T, N, W> Multiply(matrix_execution::SequencedPolicy, const Matrix<T, N, M>& lhs,
+                         const Matrix<T, M1, W>& rhs) {
+  return lhs * rhs;
+}
+
+template <class T, size_t N, size_t M, size_t M1, size_t W>
+Matrix<T, N, W> Multiply(matrix_execution::ParallelPolicy, const Matrix<T, N, M>& lhs,
+                         const Matrix<T, M1, W>& rhs) {
+  if (M != M1) {
+    throw MatrixInvalidDimensions{};
+  }
+  Matrix<T, N, W> new_matrix;
+  matrix_kernels::ParallelMultiply(lhs.inner_matrix_[0], rhs.inner_matrix_[0], new_matrix.inner_matrix_[0], N, M, W,
+                                   M, W, W);
+  return new_matrix;
+}
+
+template <class E, std::enable_if_t<kIsMatrixExpression<E>, int> = 0>
+auto Evaluate(matrix_execution::SequencedPolicy, const E& expression) {
+  Matrix<typename E::ValueType, E::kRows, E::kColumns> new_matrix = expression;
+  return new_matrix;
+}
+
+template <class E, std::enable_if_t<kIsMatrixExpression<E>, int> = 0>
+auto Evaluate(matrix_execution::ParallelPolicy, const E& expression) {
+  Matrix<typename E::ValueType, E::kRows, E::kColumns> new_matrix;
+  matrix_kernels::ParallelRowBands(E::kRows, E::kColumns, [&](size_t row_begin, size_t row_end) {
+    for (size_t i = row_begin; i < row_end; ++i) {
+      for (size_t j = 0u; j < E::kColumns; ++j) {
+        new_matrix.inner_matrix_[i][j] = expression(i, j);
+      }
+    }
+  });
+  return new_matrix;
+}
+
+template <class Policy, class L, class R,
+          std::enable_if_t<matrix_execution::kIsExecutionPolicy<Policy> && kIsMatrixExpression<L> &&
+                               kIsMatrixExpression<R>,
+                           int> = 0>
+auto Add(Policy policy, L&& lhs, R&& rhs) {
+  return Evaluate(policy, std::forward<L>(lhs) + std::forward<R>(rhs));
+}
+
+template <class Policy, class L, class R,
+          std::enable_if_t<matrix_execution::kIsExecutionPolicy<Policy> && kIsMatrixExpression<L> &&
+                               kIsMatrixExpression<R>,
+                           int> = 0>
+auto Subtract(Policy policy, L&& lhs, R&& rhs) {
+  return Evaluate(policy, std::forward<L>(lhs) - std::forward<R>(rhs));
+}
+
+template <class Policy, class E,
+          std::enable_if_t<matrix_execution::kIsExecutionPolicy<Policy> && kIsMatrixExpression<E>, int> = 0>
+auto Scale(Policy policy, E&& expression, const typename std::decay_t<E>::ValueType& num) {
+  return Evaluate(policy, std::forward<E>(expression) * num);
+}
+
+template <class T>
+DynMatrix<T> Multiply(matrix_execution::SequencedPolicy, const DynMatrix<T>& lhs, const DynMatrix<T>& rhs) {
+  return lhs * rhs;
+}
+
+template <class T>
+DynMatrix<T> Multiply(matrix_execution::ParallelPolicy, const DynMatrix<T>& lhs, const DynMatrix<T>& rhs) {
+  if (lhs.ColumnsNumber() != rhs.RowsNumber()) {
+    throw MatrixInvalidDimensions{};
+  }
+  DynMatrix<T> new_matrix(lhs.RowsNumber(), rhs.ColumnsNumber());
+  matrix_kernels::ParallelMultiply(lhs.Data(), rhs.Data(), new_matrix.Data(), lhs.RowsNumber(), lhs.ColumnsNumber(),
+                                   rhs.ColumnsNumber(), lhs.Stride(), rhs.Stride(), new_matrix.Stride());
+  return new_matrix;
+}
+
+template <class T>
+DynMatrix<T> Add(matrix_execution::SequencedPolicy, const DynMatrix<T>& lhs, const DynMatrix<T>& rhs) {
+  return lhs + rhs;
+}
+
+template <class T>
+DynMatrix<T> Add(matrix_execution::ParallelPolicy, const DynMatrix<T>& lhs, const DynMatrix<T>& rhs) {
+  if (lhs.RowsNumber() != rhs.RowsNumber() || lhs.ColumnsNumber() != rhs.ColumnsNumber()) {
+    throw MatrixInvalidDimensions{};
+  }
+  DynMatrix<T> new_matrix(lhs.RowsNumber(), lhs.ColumnsNumber());
+  matrix_kernels::ParallelRowBands(lhs.RowsNumber(), lhs.ColumnsNumber(), [&](size_t row_begin, size_t row_end) {
+    for (size_t i = row_begin; i < row_end; ++i) {
+      for (size_t j = 0u; j < lhs.ColumnsNumber(); ++j) {
+        new_matrix(i, j) = lhs(i, j) + rhs(i, j);
+      }
+    }
+  });
+  return new_matrix;
+}
+
+template <class T>
+DynMatrix<T> Subtract(matrix_execution::SequencedPolicy, const DynMatrix<T>& lhs, const DynMatrix<T>& rhs) {
+  return lhs - rhs;
+}
+
+template <class T>
+DynMatrix<T> Subtract(matrix_execution::ParallelPolicy, const DynMatrix<T>& lhs, const DynMatrix<T>& rhs) {
+  if (lhs.RowsNumber() != rhs.RowsNumber() || lhs.ColumnsNumber() != rhs.ColumnsNumber()) {
+    throw MatrixInvalidDimensions{};
+  }
+  DynMatrix<T> new_matrix(lhs.RowsNumber(), lhs.ColumnsNumber());
+  matrix_kernels::ParallelRowBands(lhs.RowsNumber(), lhs.ColumnsNumber(), [&](size_t row_begin, size_t row_end) {
+    for (size_t i = row_begin; i < row_end; ++i) {
+      for (size_t j = 0u; j < lhs.ColumnsNumber(); ++j) {
+        new_matrix(i, j) = lhs(i, j) - rhs(i, j);
+      }
+    }
+  });
+  return new_matrix;
+}
+
+template <class T>
+DynMatrix<T> Scale(matrix_execution::SequencedPolicy, const DynMatrix<T>& matrix, const T& num) {
+  return matrix * num;
+}
+
+template <class T>
+DynMatrix<T> Scale(matrix_execution::ParallelPolicy, const DynMatrix<T>& matrix, const T& num) {
+  DynMatrix<T> new_matrix(matrix.RowsNumber(), matrix.ColumnsNumber());
+  matrix_kernels::ParallelRowBands(matrix.RowsNumber(), matrix.ColumnsNumber(), [&](size_t row_begin, size_t row_end) {
+    for (size_t i = row_begin; i < row_end; ++i) {
+      for (size_t j = 0u; j < matrix.ColumnsNumber(); ++j) {
+        new_matrix(i, j) = matrix(i, j) * num;
+      }
+    }
+  });
+  return new_matrix;
+}
+
+#endif
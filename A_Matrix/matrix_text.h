@@ -0,0 +1,68 @@
+#ifndef LARGETASKS_MATRIX_TEXT_H
+#define LARGETASKS_MATRIX_TEXT_H
+
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <istream>
+#include <system_error>
+#include <type_traits>
+
+namespace matrix_text {
+
+constexpr size_t kMaxTokenLength = 128;
+
+template <class T>
+constexpr bool kHasFastParser =
+    std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char> &&
+    !std::is_same_v<T, signed char> && !std::is_same_v<T, unsigned char> &&
+#if defined(__cpp_lib_to_chars)
+    true;
+#else
+    std::is_integral_v<T>;
+#endif
+
+// Drop-in for `is >> value` on numbers: one whitespace-delimited token is pulled straight from the stream
+// buffer and parsed with std::from_chars, skipping the locale-aware num_get machinery. Errors, including tokens
+// longer than kMaxTokenLength characters, set failbit.
+template <class T>
+std::istream& ReadValue(std::istream& is, T& value) {
+  if constexpr (!kHasFastParser<T>) {
+    return is >> value;
+  } else {
+    std::istream::sentry sentry(is);
+    if (!sentry) {
+      return is;
+    }
+    std::streambuf* buffer = is.rdbuf();
+    char token[kMaxTokenLength];
+    size_t length = 0;
+    int ch = buffer->sgetc();
+    while (ch != EOF && !std::isspace(ch) && length < kMaxTokenLength) {
+      token[length++] = static_cast<char>(ch);
+      ch = buffer->snextc();
+    }
+    if (ch == EOF) {
+      is.setstate(std::ios_base::eofbit);
+    } else if (!std::isspace(ch)) {
+      // The token is longer than any number this parser accepts; reading on would split it into two values.
+      is.setstate(std::ios_base::failbit);
+      return is;
+    }
+
+    const char* begin = token;
+    if (length > 0 && token[0] == '+') {
+      ++begin;
+    }
+    auto [end, error] = std::from_chars(begin, token + length, value);
+    if (error != std::errc() || end != token + length) {
+      is.setstate(std::ios_base::failbit);
+    }
+    return is;
+  }
+}
+
+}  // namespace matrix_text
+
+#endif
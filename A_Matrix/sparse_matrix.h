@@ -0,0 +1,380 @@
+#ifndef LARGETASKS_SPARSE_MATRIX_H
+#define LARGETASKS_SPARSE_MATRIX_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "dyn_matrix.h"
+#include "matrix.h"
+#include "thread_pool.h"
+
+// Products touching fewer stored elements than this run on the calling thread only.
+constexpr size_t kSparseParallelNonZeros = 1u << 15;
+constexpr size_t kSparseBandNonZeros = 1u << 12;
+
+// Compressed sparse column layout; it is exactly the CSR layout of the transposed matrix.
+template <class T>
+struct CscStorage {
+  std::vector<size_t> column_offsets_;
+  std::vector<size_t> row_indices_;
+  std::vector<T> values_;
+};
+
+// Compressed sparse row matrix: the stored elements of row i are values_[row_offsets_[i] .. row_offsets_[i + 1])
+// with strictly increasing column_indices_. Every operation costs O(rows + non-zeros) instead of O(rows * columns).
+template <class T>
+class SparseMatrix {
+ private:
+  size_t rows_ = 0;
+  size_t columns_ = 0;
+  std::vector<size_t> row_offsets_;
+  std::vector<size_t> column_indices_;
+  std::vector<T> values_;
+
+  static bool IsSignificant(const T& value, const T& threshold) {
+    if constexpr (std::is_arithmetic_v<T> && std::is_signed_v<T>) {
+      return std::abs(value) > threshold;
+    } else {
+      return value != T() && !(value <= threshold);
+    }
+  }
+
+  void CheckStructure() const {
+    if (row_offsets_.size() != rows_ + 1 || row_offsets_.front() != 0 ||
+        row_offsets_.back() != column_indices_.size() || column_indices_.size() != values_.size()) {
+      throw MatrixInvalidDimensions{};
+    }
+    for (size_t i = 0u; i < rows_; ++i) {
+      if (row_offsets_[i] > row_offsets_[i + 1]) {
+        throw MatrixInvalidDimensions{};
+      }
+      for (size_t k = row_offsets_[i]; k < row_offsets_[i + 1]; ++k) {
+        if (column_indices_[k] >= columns_ || (k > row_offsets_[i] && column_indices_[k - 1] >= column_indices_[k])) {
+          throw MatrixInvalidDimensions{};
+        }
+      }
+    }
+  }
+
+  // Splits the rows into bands of roughly kSparseBandNonZeros stored elements each.
+  template <class Body>
+  void ForEachRowBand(size_t work_per_element, const Body& body) const {
+    size_t work = values_.size() * std::max<size_t>(1u, work_per_element);
+    if (work < kSparseParallelNonZeros || rows_ < 2) {
+      body(0u, rows_);
+      return;
+    }
+    size_t average_row_work = std::max<size_t>(1u, work / rows_);
+    DefaultThreadPool().ParallelFor(0u, rows_, std::max<size_t>(1u, kSparseBandNonZeros / average_row_work), body);
+  }
+
+  template <class Operation>
+  SparseMatrix<T> Combine(const SparseMatrix<T>& other, Operation operation) const {
+    if (rows_ != other.rows_ || columns_ != other.columns_) {
+      throw MatrixInvalidDimensions{};
+    }
+    SparseMatrix<T> new_matrix(rows_, columns_);
+    new_matrix.column_indices_.reserve(values_.size() + other.values_.size());
+    new_matrix.values_.reserve(values_.size() + other.values_.size());
+    auto push = [&new_matrix](size_t column, const T& value) {
+      if (value != T()) {
+        new_matrix.column_indices_.push_back(column);
+        new_matrix.values_.push_back(value);
+      }
+    };
+    for (size_t i = 0u; i < rows_; ++i) {
+      size_t k = row_offsets_[i];
+      size_t l = other.row_offsets_[i];
+      while (k < row_offsets_[i + 1] || l < other.row_offsets_[i + 1]) {
+        bool other_done = l == other.row_offsets_[i + 1];
+        if (other_done || (k < row_offsets_[i + 1] && column_indices_[k] < other.column_indices_[l])) {
+          push(column_indices_[k], operation(values_[k], T()));
+          ++k;
+        } else if (k == row_offsets_[i + 1] || other.column_indices_[l] < column_indices_[k]) {
+          push(other.column_indices_[l], operation(T(), other.values_[l]));
+          ++l;
+        } else {
+          push(column_indices_[k], operation(values_[k], other.values_[l]));
+          ++k;
+          ++l;
+        }
+      }
+      new_matrix.row_offsets_[i + 1] = new_matrix.values_.size();
+    }
+    return new_matrix;
+  }
+
+  // out[rows_ x w] = *this * dense[columns_ x w], both dense operands addressed through row strides.
+  void MultiplyDense(const T* dense, size_t w, size_t ld_dense, T* out, size_t ld_out) const {
+    ForEachRowBand(w, [&](size_t row_begin, size_t row_end) {
+      for (size_t i = row_begin; i < row_end; ++i) {
+        T* out_row = out + i * ld_out;
+        std::fill(out_row, out_row + w, T());
+        for (size_t k = row_offsets_[i]; k < row_offsets_[i + 1]; ++k) {
+          const T value = values_[k];
+          const T* dense_row = dense + column_indices_[k] * ld_dense;
+          for (size_t j = 0u; j < w; ++j) {
+            out_row[j] += value * dense_row[j];
+          }
+        }
+      }
+    });
+  }
+
+ public:
+  SparseMatrix() : row_offsets_(1, 0) {
+  }
+
+  SparseMatrix(size_t rows, size_t columns) : rows_(rows), columns_(columns), row_offsets_(rows + 1, 0) {
+  }
+
+  SparseMatrix(size_t rows, size_t columns, std::vector<size_t> row_offsets, std::vector<size_t> column_indices,
+               std::vector<T> values)
+      : rows_(rows),
+        columns_(columns),
+        row_offsets_(std::move(row_offsets)),
+        column_indices_(std::move(column_indices)),
+        values_(std::move(values)) {
+    CheckStructure();
+  }
+
+  // Keeps the elements whose magnitude exceeds `threshold`; the default keeps every non-zero.
+  template <size_t N, size_t M>
+  static SparseMatrix<T> FromDense(const Matrix<T, N, M>& matrix, const T& threshold = T()) {
+    return FromDense(matrix.inner_matrix_[0], N, M, M, threshold);
+  }
+
+  static SparseMatrix<T> FromDense(const DynMatrix<T>& matrix, const T& threshold = T()) {
+    return FromDense(matrix.Data(), matrix.RowsNumber(), matrix.ColumnsNumber(), matrix.Stride(), threshold);
+  }
+
+  static SparseMatrix<T> FromDense(const T* data, size_t rows, size_t columns, size_t stride,
+                                   const T& threshold = T()) {
+    SparseMatrix<T> new_matrix(rows, columns);
+    for (size_t i = 0u; i < rows; ++i) {
+      const T* row = data + i * stride;
+      for (size_t j = 0u; j < columns; ++j) {
+        if (IsSignificant(row[j], threshold)) {
+          new_matrix.column_indices_.push_back(j);
+          new_matrix.values_.push_back(row[j]);
+        }
+      }
+      new_matrix.row_offsets_[i + 1] = new_matrix.values_.size();
+    }
+    return new_matrix;
+  }
+
+  static SparseMatrix<T> FromCsc(size_t rows, size_t columns, CscStorage<T> storage) {
+    SparseMatrix<T> transposed(columns, rows, std::move(storage.column_offsets_), std::move(storage.row_indices_),
+                               std::move(storage.values_));
+    return transposed.GetTransposed();
+  }
+
+  CscStorage<T> ToCsc() const {
+    SparseMatrix<T> transposed = GetTransposed();
+    return {std::move(transposed.row_offsets_), std::move(transposed.column_indices_), std::move(transposed.values_)};
+  }
+
+  DynMatrix<T> ToDynMatrix() const {
+    DynMatrix<T> matrix(rows_, columns_);
+    for (size_t i = 0u; i < rows_; ++i) {
+      for (size_t k = row_offsets_[i]; k < row_offsets_[i + 1]; ++k) {
+        matrix(i, column_indices_[k]) = values_[k];
+      }
+    }
+    return matrix;
+  }
+
+  template <size_t N, size_t M>
+  Matrix<T, N, M> ToMatrix() const {
+    if (rows_ != N || columns_ != M) {
+      throw MatrixInvalidDimensions{};
+    }
+    Matrix<T, N, M> matrix{};
+    for (size_t i = 0u; i < N; ++i) {
+      for (size_t k = row_offsets_[i]; k < row_offsets_[i + 1]; ++k) {
+        matrix.inner_matrix_[i][column_indices_[k]] = values_[k];
+      }
+    }
+    return matrix;
+  }
+
+  // Counting sort over the column indices: O(rows + columns + non-zeros) and keeps every row sorted.
+  SparseMatrix<T> GetTransposed() const {
+    SparseMatrix<T> transposed(columns_, rows_);
+    for (size_t column : column_indices_) {
+      ++transposed.row_offsets_[column + 1];
+    }
+    for (size_t j = 0u; j < columns_; ++j) {
+      transposed.row_offsets_[j + 1] += transposed.row_offsets_[j];
+    }
+    transposed.column_indices_.resize(values_.size());
+    transposed.values_.resize(values_.size());
+    std::vector<size_t> next(transposed.row_offsets_.begin(), transposed.row_offsets_.end() - 1);
+    for (size_t i = 0u; i < rows_; ++i) {
+      for (size_t k = row_offsets_[i]; k < row_offsets_[i + 1]; ++k) {
+        size_t position = next[column_indices_[k]]++;
+        transposed.column_indices_[position] = i;
+        transposed.values_[position] = values_[k];
+      }
+    }
+    return transposed;
+  }
+
+  [[nodiscard]] size_t RowsNumber() const noexcept {
+    return rows_;
+  }
+
+  [[nodiscard]] size_t ColumnsNumber() const noexcept {
+    return columns_;
+  }
+
+  [[nodiscard]] size_t NonZerosNumber() const noexcept {
+    return values_.size();
+  }
+
+  const std::vector<size_t>& RowOffsets() const noexcept {
+    return row_offsets_;
+  }
+
+  const std::vector<size_t>& ColumnIndices() const noexcept {
+    return column_indices_;
+  }
+
+  const std::vector<T>& Values() const noexcept {
+    return values_;
+  }
+
+  T operator()(size_t n, size_t m) const {
+    auto row_begin = column_indices_.begin() + static_cast<std::ptrdiff_t>(row_offsets_[n]);
+    auto row_end = column_indices_.begin() + static_cast<std::ptrdiff_t>(row_offsets_[n + 1]);
+    auto it = std::lower_bound(row_begin, row_end, m);
+    if (it == row_end || *it != m) {
+      return T();
+    }
+    return values_[static_cast<size_t>(it - column_indices_.begin())];
+  }
+
+  T At(size_t n, size_t m) const {
+    if (n >= rows_ || m >= columns_) {
+      throw MatrixOutOfRange();
+    }
+    return (*this)(n, m);
+  }
+
+  SparseMatrix<T> operator+(const SparseMatrix<T>& other) const {
+    return Combine(other, std::plus<>{});
+  }
+
+  SparseMatrix<T> operator-(const SparseMatrix<T>& other) const {
+    return Combine(other, std::minus<>{});
+  }
+
+  SparseMatrix<T>& operator+=(const SparseMatrix<T>& other) {
+    *this = *this + other;
+    return *this;
+  }
+
+  SparseMatrix<T>& operator-=(const SparseMatrix<T>& other) {
+    *this = *this - other;
+    return *this;
+  }
+
+  SparseMatrix<T> operator*(const T& num) const {
+    SparseMatrix<T> new_matrix(*this);
+    new_matrix *= num;
+    return new_matrix;
+  }
+
+  friend SparseMatrix<T> operator*(const T& num, const SparseMatrix<T>& matrix) {
+    return matrix * num;
+  }
+
+  SparseMatrix<T>& operator*=(const T& num) {
+    for (T& value : values_) {
+      value *= num;
+    }
+    return *this;
+  }
+
+  // SpMV; rows are split into bands of similar non-zero count and run on the default thread pool.
+  std::vector<T> operator*(const std::vector<T>& vector) const {
+    if (vector.size() != columns_) {
+      throw MatrixInvalidDimensions{};
+    }
+    std::vector<T> result(rows_);
+    ForEachRowBand(1u, [&](size_t row_begin, size_t row_end) {
+      for (size_t i = row_begin; i < row_end; ++i) {
+        T sum = T();
+        for (size_t k = row_offsets_[i]; k < row_offsets_[i + 1]; ++k) {
+          sum += values_[k] * vector[column_indices_[k]];
+        }
+        result[i] = sum;
+      }
+    });
+    return result;
+  }
+
+  DynMatrix<T> operator*(const DynMatrix<T>& other) const {
+    if (columns_ != other.RowsNumber()) {
+      throw MatrixInvalidDimensions{};
+    }
+    DynMatrix<T> new_matrix(rows_, other.ColumnsNumber());
+    MultiplyDense(other.Data(), other.ColumnsNumber(), other.Stride(), new_matrix.Data(), new_matrix.Stride());
+    return new_matrix;
+  }
+
+  template <size_t M, size_t W>
+  DynMatrix<T> operator*(const Matrix<T, M, W>& other) const {
+    if (columns_ != M) {
+      throw MatrixInvalidDimensions{};
+    }
+    DynMatrix<T> new_matrix(rows_, W);
+    MultiplyDense(other.inner_matrix_[0], W, W, new_matrix.Data(), new_matrix.Stride());
+    return new_matrix;
+  }
+
+  bool operator==(const SparseMatrix<T>& other) const {
+    return rows_ == other.rows_ && columns_ == other.columns_ && row_offsets_ == other.row_offsets_ &&
+           column_indices_ == other.column_indices_ && values_ == other.values_;
+  }
+
+  bool operator!=(const SparseMatrix<T>& other) const {
+    return !(*this == other);
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, const SparseMatrix<T>& matrix) {
+    for (size_t i = 0u; i < matrix.rows_; ++i) {
+      for (size_t j = 0u; j < matrix.columns_; ++j) {
+        os << matrix(i, j) << (j == matrix.columns_ - 1 ? "\n" : " ");
+      }
+    }
+    return os;
+  }
+};
+
+template <class T>
+T Trace(const SparseMatrix<T>& matrix) {
+  if (matrix.RowsNumber() != matrix.ColumnsNumber()) {
+    throw MatrixInvalidDimensions{};
+  }
+  T matrix_trace = T();
+  for (size_t i = 0u; i < matrix.RowsNumber(); ++i) {
+    matrix_trace += matrix(i, i);
+  }
+  return matrix_trace;
+}
+
+template <class T>
+SparseMatrix<T> GetTransposed(const SparseMatrix<T>& matrix) {
+  return matrix.GetTransposed();
+}
+
+#endif
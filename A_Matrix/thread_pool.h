@@ -0,0 +1,210 @@
+#ifndef LARGETASKS_THREAD_POOL_H
+#define LARGETASKS_THREAD_POOL_H
+
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Every worker owns a deque: it pops its own work LIFO and steals from the other end of its neighbours' deques.
+class ThreadPool {
+ private:
+  struct WorkerQueue {
+    std::mutex mutex_;
+    std::deque<std::function<void()>> tasks_;
+  };
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_up_;
+  std::atomic<size_t> pending_tasks_{0};
+  std::atomic<size_t> next_queue_{0};
+  bool stop_ = false;
+
+  static inline thread_local ThreadPool* current_pool_ = nullptr;
+  static inline thread_local size_t current_worker_ = 0;
+
+  bool PopOwn(size_t worker, std::function<void()>& task) {
+    WorkerQueue& queue = *queues_[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex_);
+    if (queue.tasks_.empty()) {
+      return false;
+    }
+    task = std::move(queue.tasks_.back());
+    queue.tasks_.pop_back();
+    return true;
+  }
+
+  bool Steal(size_t thief, std::function<void()>& task) {
+    for (size_t offset = 1; offset <= queues_.size(); ++offset) {
+      WorkerQueue& queue = *queues_[(thief + offset) % queues_.size()];
+      std::lock_guard<std::mutex> lock(queue.mutex_);
+      if (!queue.tasks_.empty()) {
+        task = std::move(queue.tasks_.front());
+        queue.tasks_.pop_front();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool TakeTask(size_t worker, std::function<void()>& task) {
+    if (PopOwn(worker, task) || Steal(worker, task)) {
+      pending_tasks_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+    return false;
+  }
+
+  void WorkerLoop(size_t worker) {
+    current_pool_ = this;
+    current_worker_ = worker;
+    std::function<void()> task;
+    while (true) {
+      if (TakeTask(worker, task)) {
+        task();
+        task = nullptr;
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      wake_up_.wait(lock, [this] { return stop_ || pending_tasks_.load(std::memory_order_relaxed) > 0; });
+      if (stop_ && pending_tasks_.load(std::memory_order_relaxed) == 0) {
+        return;
+      }
+    }
+  }
+
+ public:
+  explicit ThreadPool(size_t n_threads = std::max<size_t>(1u, std::thread::hardware_concurrency())) {
+    n_threads = std::max<size_t>(1u, n_threads);
+    for (size_t i = 0u; i < n_threads; ++i) {
+      queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (size_t i = 0u; i < n_threads; ++i) {
+      workers_.emplace_back([this, i] { WorkerLoop(i); });
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  [[nodiscard]] size_t ThreadsNumber() const noexcept {
+    return workers_.size();
+  }
+
+  void Submit(std::function<void()> task) {
+    size_t queue_id = (current_pool_ == this ? current_worker_
+                                             : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size());
+    // Counted before it is published, so a worker that takes it at once never drives the counter below zero.
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      pending_tasks_.fetch_add(1, std::memory_order_relaxed);
+    }
+    try {
+      std::lock_guard<std::mutex> lock(queues_[queue_id]->mutex_);
+      queues_[queue_id]->tasks_.push_back(std::move(task));
+    } catch (...) {
+      pending_tasks_.fetch_sub(1, std::memory_order_relaxed);
+      throw;
+    }
+    wake_up_.notify_one();
+  }
+
+  // Runs one queued task on the calling thread, so a thread that waits on the pool keeps it busy instead.
+  bool RunPendingTask() {
+    std::function<void()> task;
+    size_t worker = (current_pool_ == this ? current_worker_ : 0u);
+    if (!TakeTask(worker, task)) {
+      return false;
+    }
+    task();
+    return true;
+  }
+
+  // Calls body(chunk_begin, chunk_end) over [begin, end) split into chunks of at least `grain` and blocks until
+  // all of them finish; the calling thread takes part. The first exception thrown by body is rethrown here.
+  template <class Body>
+  void ParallelFor(size_t begin, size_t end, size_t grain, const Body& body) {
+    if (begin >= end) {
+      return;
+    }
+    grain = std::max<size_t>(1u, grain);
+    size_t n_chunks = std::min((end - begin + grain - 1) / grain, 4 * ThreadsNumber());
+    if (n_chunks <= 1) {
+      body(begin, end);
+      return;
+    }
+    size_t chunk_size = (end - begin + n_chunks - 1) / n_chunks;
+
+    std::atomic<size_t> remaining{n_chunks};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto run_chunk = [&](size_t chunk) {
+      size_t chunk_begin = begin + chunk * chunk_size;
+      size_t chunk_end = std::min(end, chunk_begin + chunk_size);
+      try {
+        if (chunk_begin < chunk_end) {
+          body(chunk_begin, chunk_end);
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+      remaining.fetch_sub(1, std::memory_order_acq_rel);
+    };
+
+    auto wait_for_chunks = [&] {
+      while (remaining.load(std::memory_order_acquire) != 0) {
+        if (!RunPendingTask()) {
+          std::this_thread::yield();
+        }
+      }
+    };
+
+    // Queued chunks refer to this frame, so a failed Submit waits for them before the exception leaves it.
+    size_t submitted = 1;
+    try {
+      for (; submitted < n_chunks; ++submitted) {
+        Submit([&run_chunk, chunk = submitted] { run_chunk(chunk); });
+      }
+    } catch (...) {
+      remaining.fetch_sub(n_chunks - submitted + 1, std::memory_order_acq_rel);
+      wait_for_chunks();
+      throw;
+    }
+    run_chunk(0);
+    wait_for_chunks();
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      stop_ = true;
+    }
+    wake_up_.notify_all();
+    for (std::thread& worker : workers_) {
+      worker.join();
+    }
+  }
+};
+
+inline ThreadPool& DefaultThreadPool() {
+  static ThreadPool pool;
+  return pool;
+}
+
+#endif
@@ -6,107 +6,264 @@
 #include <cstdlib>
 #include <exception>
 #include <algorithm>
+#include <type_traits>
+#include <utility>
 
 class ArrayOutOfRange : std::exception {};
 
+// Widest vector register the target is compiled for, in bytes.
+#if defined(__AVX512F__)
+inline constexpr size_t kArraySimdWidth = 64;
+#elif defined(__AVX__)
+inline constexpr size_t kArraySimdWidth = 32;
+#else
+inline constexpr size_t kArraySimdWidth = 16;
+#endif
+
+// Arithmetic arrays are aligned to the SIMD width, capped by the lowest set bit of their byte size so that
+// sizeof(Array<T, N>) stays sizeof(T) * N and arrays of Arrays keep packing densely; other types keep alignof(T).
 template <class T, size_t N>
+inline constexpr size_t kArrayDefaultAlignment =
+    std::is_arithmetic_v<T> ? std::max(alignof(T), std::min(kArraySimdWidth, (sizeof(T) * N) & (~(sizeof(T) * N) + 1)))
+                            : alignof(T);
+
+template <class T, size_t N, size_t Alignment = kArrayDefaultAlignment<T, N>>
 class Array {
+  static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0,
+                "Array alignment must be a power of two not below alignof(T)");
+
+ private:
+  // Number of independent accumulators in the reductions: one SIMD register worth of T, so the unrolled lanes map
+  // onto vector lanes without reassociating floating-point sums across them.
+  static constexpr size_t kLanes = std::is_arithmetic_v<T> ? std::max<size_t>(1, kArraySimdWidth / sizeof(T)) : 1;
+  static constexpr size_t kVectorizedSize = N / kLanes * kLanes;
+
+  using LaneIndices = std::make_index_sequence<kLanes>;
+
+  static constexpr void SwapValues(T& lhs, T& rhs) {
+    T temporary = std::move(lhs);
+    lhs = std::move(rhs);
+    rhs = std::move(temporary);
+  }
+
+  template <size_t... Lanes>
+  constexpr void FillLanes(const T& value, std::index_sequence<Lanes...>) {
+    for (size_t i = 0u; i < kVectorizedSize; i += kLanes) {
+      ((inner_array_[i + Lanes] = value), ...);
+    }
+    for (size_t i = kVectorizedSize; i < N; ++i) {
+      inner_array_[i] = value;
+    }
+  }
+
+  template <class Accumulate, size_t... Lanes>
+  constexpr T Reduce(const Accumulate& accumulate, std::index_sequence<Lanes...>) const {
+    if constexpr (N < kLanes) {
+      T result = inner_array_[0];
+      for (size_t i = 1u; i < N; ++i) {
+        result = accumulate(result, inner_array_[i]);
+      }
+      return result;
+    } else {
+      T partial[kLanes] = {inner_array_[Lanes]...};
+      for (size_t i = kLanes; i < kVectorizedSize; i += kLanes) {
+        ((partial[Lanes] = accumulate(partial[Lanes], inner_array_[i + Lanes])), ...);
+      }
+      for (size_t i = kVectorizedSize; i < N; ++i) {
+        partial[0] = accumulate(partial[0], inner_array_[i]);
+      }
+      for (size_t width = kLanes / 2; width > 0; width /= 2) {
+        for (size_t lane = 0u; lane < width; ++lane) {
+          partial[lane] = accumulate(partial[lane], partial[lane + width]);
+        }
+      }
+      return partial[0];
+    }
+  }
+
+  template <size_t... Lanes>
+  constexpr T DotProduct(const Array<T, N, Alignment>& other, std::index_sequence<Lanes...>) const {
+    T partial[kLanes] = {(static_cast<void>(Lanes), T())...};
+    for (size_t i = 0u; i < kVectorizedSize; i += kLanes) {
+      ((partial[Lanes] += inner_array_[i + Lanes] * other.inner_array_[i + Lanes]), ...);
+    }
+    for (size_t i = kVectorizedSize; i < N; ++i) {
+      partial[0] += inner_array_[i] * other.inner_array_[i];
+    }
+    for (size_t width = kLanes / 2; width > 0; width /= 2) {
+      for (size_t lane = 0u; lane < width; ++lane) {
+        partial[lane] += partial[lane + width];
+      }
+    }
+    return partial[0];
+  }
+
+  template <size_t... Lanes>
+  constexpr bool Equal(const Array<T, N, Alignment>& other, std::index_sequence<Lanes...>) const {
+    for (size_t i = 0u; i < kVectorizedSize; i += kLanes) {
+      // The whole block is compared without branching so that it becomes a single vector comparison.
+      if (!((inner_array_[i + Lanes] == other.inner_array_[i + Lanes]) & ...)) {
+        return false;
+      }
+    }
+    for (size_t i = kVectorizedSize; i < N; ++i) {
+      if (!(inner_array_[i] == other.inner_array_[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
  public:
-  T inner_array_[N];
+  static constexpr size_t kAlignment = Alignment;
+
+  alignas(Alignment) T inner_array_[N];
 
-  T& operator[](size_t n) {
+  constexpr T& operator[](size_t n) {
     return inner_array_[n];
   }
 
-  const T& operator[](size_t n) const {
+  constexpr const T& operator[](size_t n) const {
     return inner_array_[n];
   }
 
-  T& At(size_t n) {
+  constexpr T& At(size_t n) {
     if (n >= N) {
       throw ArrayOutOfRange{};
     }
     return inner_array_[n];
   }
 
-  const T& At(size_t n) const {
+  constexpr const T& At(size_t n) const {
     if (n >= N) {
       throw ArrayOutOfRange{};
     }
     return inner_array_[n];
   }
 
-  T& Front() {
+  constexpr T& Front() {
     return inner_array_[0];
   }
 
-  const T& Front() const {
+  constexpr const T& Front() const {
     return inner_array_[0];
   }
 
-  T& Back() {
+  constexpr T& Back() {
     return inner_array_[N - 1];
   }
 
-  const T& Back() const {
+  constexpr const T& Back() const {
     return inner_array_[N - 1];
   }
 
-  T* Data() {
+  constexpr T* Data() {
     return inner_array_;
   }
 
-  const T* Data() const {
+  constexpr const T* Data() const {
     return inner_array_;
   }
 
-  [[nodiscard]] size_t Size() const {
+  [[nodiscard]] constexpr size_t Size() const {
     return N;
   }
 
-  [[nodiscard]] bool Empty() const {
+  [[nodiscard]] constexpr bool Empty() const {
     return N == 0;
   }
 
-  void Fill(const T& value) {
+  constexpr void Fill(const T& value) {
+    FillLanes(value, LaneIndices{});
+  }
+
+  constexpr void Swap(Array<T, N, Alignment>& other) {
     for (size_t i = 0u; i < N; ++i) {
-      inner_array_[i] = value;
+      SwapValues(inner_array_[i], other.inner_array_[i]);
     }
   }
 
-  void Swap(Array<T, N>& other) {
-    std::swap(inner_array_, other.inner_array_);
+  // Reductions keep kLanes partial results and combine them pairwise at the end, so floating-point results may
+  // differ from a left-to-right loop in the last bits.
+  constexpr T Sum() const {
+    return Reduce([](const T& lhs, const T& rhs) { return lhs + rhs; }, LaneIndices{});
+  }
+
+  constexpr T Min() const {
+    return Reduce([](const T& lhs, const T& rhs) { return (rhs < lhs ? rhs : lhs); }, LaneIndices{});
+  }
+
+  constexpr T Max() const {
+    return Reduce([](const T& lhs, const T& rhs) { return (lhs < rhs ? rhs : lhs); }, LaneIndices{});
+  }
+
+  constexpr T Dot(const Array<T, N, Alignment>& other) const {
+    return DotProduct(other, LaneIndices{});
+  }
+
+  constexpr bool operator==(const Array<T, N, Alignment>& other) const {
+    return Equal(other, LaneIndices{});
+  }
+
+  constexpr bool operator!=(const Array<T, N, Alignment>& other) const {
+    return !(*this == other);
   }
 };
 
 template <class T>
-size_t GetSize(const T&) {
+constexpr size_t GetSize(const T&) {
   return 0;
 }
 
 template <class T, size_t N>
-size_t GetSize(const T (&)[N]) {
+constexpr size_t GetSize(const T (&)[N]) {
   return N;
 }
 
 template <class T>
-size_t GetRank(const T&) {
+constexpr size_t GetRank(const T&) {
   return 0;
 }
 
 template <class T, size_t N>
-size_t GetRank(const T (&)[N]) {
+constexpr size_t GetRank(const T (&)[N]) {
   return GetRank(T{}) + 1;
 }
 
 template <class T>
-size_t GetNumElements(const T&) {
+constexpr size_t GetNumElements(const T&) {
   return 1;
 }
 
 template <class T, size_t N>
-size_t GetNumElements(const T (&)[N]) {
+constexpr size_t GetNumElements(const T (&)[N]) {
   return GetNumElements(T{}) * N;
 }
 
+template <class T, size_t N, size_t Alignment>
+constexpr size_t GetSize(const Array<T, N, Alignment>&) {
+  return N;
+}
+
+template <class T, size_t N, size_t Alignment>
+constexpr size_t GetRank(const Array<T, N, Alignment>&) {
+  return GetRank(T{}) + 1;
+}
+
+template <class T, size_t N, size_t Alignment>
+constexpr size_t GetNumElements(const Array<T, N, Alignment>&) {
+  return GetNumElements(T{}) * N;
+}
+
+// Builds Array{generator(0), ..., generator(N - 1)}; a constexpr generator makes it a compile-time lookup table:
+//   constexpr auto kSquares = MakeTable<256>([](size_t i) { return static_cast<uint32_t>(i * i); });
+template <size_t N, class Generator>
+constexpr auto MakeTable(const Generator& generator) {
+  Array<std::decay_t<decltype(generator(size_t{}))>, N> table{};
+  for (size_t i = 0u; i < N; ++i) {
+    table.inner_array_[i] = generator(i);
+  }
+  return table;
+}
+
 #endif
@@ -0,0 +1,241 @@
+#ifndef LARGETASKS_ND_ARRAY_H
+#define LARGETASKS_ND_ARRAY_H
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "array.h"
+
+// Row-major stride of dimension `rank` for an array of shape Dims...: the product of the extents after it.
+template <size_t... Dims>
+constexpr size_t NdStride(size_t rank) {
+  constexpr size_t kExtents[] = {Dims...};
+  size_t stride = 1;
+  for (size_t r = rank + 1; r < sizeof...(Dims); ++r) {
+    stride *= kExtents[r];
+  }
+  return stride;
+}
+
+// Compile-time shape shared by NdArray and NdView. Offset folds every index against a stride that is a constant
+// expression, so indexing costs one multiply-add per dimension by a known constant.
+template <size_t... Dims>
+struct NdShape {
+  static_assert(sizeof...(Dims) > 0, "NdShape needs at least one dimension");
+
+  static constexpr size_t kRank = sizeof...(Dims);
+  static constexpr size_t kNumElements = (Dims * ...);
+
+  static constexpr size_t Extent(size_t rank) {
+    constexpr size_t kExtents[] = {Dims...};
+    return kExtents[rank];
+  }
+
+  static constexpr size_t Stride(size_t rank) {
+    return NdStride<Dims...>(rank);
+  }
+
+  template <class... Indices>
+  static constexpr size_t Offset(Indices... indices) {
+    static_assert(sizeof...(Indices) == kRank, "One index per dimension is required");
+    return OffsetOf(std::index_sequence_for<Indices...>{}, static_cast<size_t>(indices)...);
+  }
+
+  template <class... Indices>
+  static constexpr bool Contains(Indices... indices) {
+    static_assert(sizeof...(Indices) == kRank, "One index per dimension is required");
+    return ((static_cast<size_t>(indices) < Dims) && ...);
+  }
+
+ private:
+  template <size_t... Ranks, class... Indices>
+  static constexpr size_t OffsetOf(std::index_sequence<Ranks...>, Indices... indices) {
+    return ((indices * std::integral_constant<size_t, NdStride<Dims...>(Ranks)>::value) + ...);
+  }
+};
+
+// Non-owning view of kNumElements contiguous elements laid out with shape First, Rest... (row-major).
+template <class T, size_t First, size_t... Rest>
+class NdView {
+ public:
+  using Shape = NdShape<First, Rest...>;
+
+  static constexpr size_t kRank = Shape::kRank;
+  static constexpr size_t kNumElements = Shape::kNumElements;
+
+ private:
+  T* data_;
+
+ public:
+  constexpr explicit NdView(T* data) noexcept : data_(data) {
+  }
+
+  // A view of the same elements may always be taken as read-only.
+  template <class U, class = std::enable_if_t<std::is_same_v<const U, T>>>
+  constexpr NdView(const NdView<U, First, Rest...>& other) noexcept : data_(other.Data()) {  // NOLINT
+  }
+
+  template <class... Indices>
+  constexpr T& operator()(Indices... indices) const {
+    return data_[Shape::Offset(indices...)];
+  }
+
+  template <class... Indices>
+  constexpr T& At(Indices... indices) const {
+    if (!Shape::Contains(indices...)) {
+      throw ArrayOutOfRange{};
+    }
+    return data_[Shape::Offset(indices...)];
+  }
+
+  constexpr T* Data() const noexcept {
+    return data_;
+  }
+
+  [[nodiscard]] static constexpr size_t Size() noexcept {
+    return First;
+  }
+
+  // The same elements seen with another shape of equal size.
+  template <size_t... Dims>
+  constexpr NdView<T, Dims...> Reshape() const noexcept {
+    static_assert(NdShape<Dims...>::kNumElements == kNumElements, "Reshape must keep the number of elements");
+    return NdView<T, Dims...>(data_);
+  }
+
+  // The sub-array at index n of the first dimension; only views of rank above one have one.
+  template <bool kHasSubArray = (sizeof...(Rest) > 0), class = std::enable_if_t<kHasSubArray>>
+  constexpr auto Slice(size_t n) const noexcept {
+    return NdView<T, Rest...>(data_ + n * Shape::Stride(0));
+  }
+};
+
+// Multi-dimensional array with compile-time shape First, Rest... stored flat and row-major in an Array, so it is
+// an aggregate with the same layout as the nested C array T[First][Rest]....
+template <class T, size_t First, size_t... Rest>
+class NdArray {
+ public:
+  using Shape = NdShape<First, Rest...>;
+  using View = NdView<T, First, Rest...>;
+  using ConstView = NdView<const T, First, Rest...>;
+
+  static constexpr size_t kRank = Shape::kRank;
+  static constexpr size_t kNumElements = Shape::kNumElements;
+
+  Array<T, kNumElements> elements_;
+
+  template <class... Indices>
+  constexpr T& operator()(Indices... indices) {
+    return elements_.inner_array_[Shape::Offset(indices...)];
+  }
+
+  template <class... Indices>
+  constexpr const T& operator()(Indices... indices) const {
+    return elements_.inner_array_[Shape::Offset(indices...)];
+  }
+
+  template <class... Indices>
+  constexpr T& At(Indices... indices) {
+    if (!Shape::Contains(indices...)) {
+      throw ArrayOutOfRange{};
+    }
+    return elements_.inner_array_[Shape::Offset(indices...)];
+  }
+
+  template <class... Indices>
+  constexpr const T& At(Indices... indices) const {
+    if (!Shape::Contains(indices...)) {
+      throw ArrayOutOfRange{};
+    }
+    return elements_.inner_array_[Shape::Offset(indices...)];
+  }
+
+  constexpr T* Data() noexcept {
+    return elements_.inner_array_;
+  }
+
+  constexpr const T* Data() const noexcept {
+    return elements_.inner_array_;
+  }
+
+  [[nodiscard]] static constexpr size_t Size() noexcept {
+    return First;
+  }
+
+  constexpr void Fill(const T& value) {
+    elements_.Fill(value);
+  }
+
+  constexpr void Swap(NdArray<T, First, Rest...>& other) {
+    elements_.Swap(other.elements_);
+  }
+
+  constexpr View GetView() noexcept {
+    return View(Data());
+  }
+
+  constexpr ConstView GetView() const noexcept {
+    return ConstView(Data());
+  }
+
+  template <size_t... Dims>
+  constexpr NdView<T, Dims...> Reshape() noexcept {
+    return GetView().template Reshape<Dims...>();
+  }
+
+  template <size_t... Dims>
+  constexpr NdView<const T, Dims...> Reshape() const noexcept {
+    return GetView().template Reshape<Dims...>();
+  }
+
+  template <bool kHasSubArray = (sizeof...(Rest) > 0), class = std::enable_if_t<kHasSubArray>>
+  constexpr auto Slice(size_t n) noexcept {
+    return GetView().Slice(n);
+  }
+
+  template <bool kHasSubArray = (sizeof...(Rest) > 0), class = std::enable_if_t<kHasSubArray>>
+  constexpr auto Slice(size_t n) const noexcept {
+    return GetView().Slice(n);
+  }
+
+  constexpr bool operator==(const NdArray<T, First, Rest...>& other) const {
+    return elements_ == other.elements_;
+  }
+
+  constexpr bool operator!=(const NdArray<T, First, Rest...>& other) const {
+    return !(*this == other);
+  }
+};
+
+template <class T, size_t First, size_t... Rest>
+constexpr size_t GetSize(const NdArray<T, First, Rest...>&) {
+  return First;
+}
+
+template <class T, size_t First, size_t... Rest>
+constexpr size_t GetSize(const NdView<T, First, Rest...>&) {
+  return First;
+}
+
+template <class T, size_t First, size_t... Rest>
+constexpr size_t GetRank(const NdArray<T, First, Rest...>&) {
+  return GetRank(std::remove_const_t<T>{}) + sizeof...(Rest) + 1;
+}
+
+template <class T, size_t First, size_t... Rest>
+constexpr size_t GetRank(const NdView<T, First, Rest...>&) {
+  return GetRank(std::remove_const_t<T>{}) + sizeof...(Rest) + 1;
+}
+
+template <class T, size_t First, size_t... Rest>
+constexpr size_t GetNumElements(const NdArray<T, First, Rest...>&) {
+  return GetNumElements(std::remove_const_t<T>{}) * NdShape<First, Rest...>::kNumElements;
+}
+
+template <class T, size_t First, size_t... Rest>
+constexpr size_t GetNumElements(const NdView<T, First, Rest...>&) {
+  return GetNumElements(std::remove_const_t<T>{}) * NdShape<First, Rest...>::kNumElements;
+}
+
+#endif
@@ -0,0 +1,373 @@
+#ifndef LARGETASKS_STATIC_VECTOR_H
+#define LARGETASKS_STATIC_VECTOR_H
+
+#include <cstdint>
+#include <algorithm>
+#include <exception>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "array.h"
+
+class StaticVectorOverflow : std::exception {};
+
+// Inline storage for up to N elements of which the first size_ are alive. Slots are raw bytes, so nothing is
+// constructed until it is pushed. This layer is trivially copyable and destructible; the specialization below adds
+// element-wise copy, move and destruction when T needs them.
+template <class T, size_t N, bool = std::is_trivially_copyable_v<T>>
+class StaticVectorStorage {
+ protected:
+  size_t size_ = 0;
+  alignas(T) unsigned char storage_[N * sizeof(T)];
+
+  T* Elements() noexcept {
+    return std::launder(reinterpret_cast<T*>(storage_));
+  }
+
+  const T* Elements() const noexcept {
+    return std::launder(reinterpret_cast<const T*>(storage_));
+  }
+
+  void DestroyFrom(size_t n) noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      std::destroy(Elements() + n, Elements() + size_);
+    }
+    size_ = std::min(size_, n);
+  }
+};
+
+template <class T, size_t N>
+class StaticVectorStorage<T, N, false> : public StaticVectorStorage<T, N, true> {
+ private:
+  using Base = StaticVectorStorage<T, N, true>;
+
+  // Copies or moves (for a non-const source) every element of other into this empty storage.
+  template <class Source>
+  void ConstructFrom(Source& other) {
+    try {
+      for (size_t i = 0u; i < other.size_; ++i) {
+        if constexpr (std::is_const_v<Source>) {
+          ::new (static_cast<void*>(this->Elements() + i)) T(other.Elements()[i]);
+        } else {
+          ::new (static_cast<void*>(this->Elements() + i)) T(std::move(other.Elements()[i]));
+        }
+        this->size_ = i + 1;
+      }
+    } catch (...) {
+      this->DestroyFrom(0);
+      throw;
+    }
+  }
+
+ public:
+  StaticVectorStorage() noexcept = default;
+
+  StaticVectorStorage(const StaticVectorStorage<T, N, false>& other) : Base() {
+    ConstructFrom(other);
+  }
+
+  StaticVectorStorage(StaticVectorStorage<T, N, false>&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+      : Base() {
+    ConstructFrom(other);
+  }
+
+  StaticVectorStorage<T, N, false>& operator=(const StaticVectorStorage<T, N, false>& other) {
+    if (this != &other) {
+      this->DestroyFrom(0);
+      ConstructFrom(other);
+    }
+    return *this;
+  }
+
+  StaticVectorStorage<T, N, false>& operator=(StaticVectorStorage<T, N, false>&& other) noexcept(
+      std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+      this->DestroyFrom(0);
+      ConstructFrom(other);
+    }
+    return *this;
+  }
+
+  ~StaticVectorStorage() noexcept {
+    this->DestroyFrom(0);
+  }
+};
+
+// The storage above always declares its element-wise copy operations, so StaticVector also derives from this to
+// delete copying when T itself cannot be copy-constructed.
+template <bool kCopyable>
+struct StaticVectorCopyControl {};
+
+template <>
+struct StaticVectorCopyControl<false> {
+  StaticVectorCopyControl() noexcept = default;
+  StaticVectorCopyControl(const StaticVectorCopyControl&) = delete;
+  StaticVectorCopyControl(StaticVectorCopyControl&&) noexcept = default;
+  StaticVectorCopyControl& operator=(const StaticVectorCopyControl&) = delete;
+  StaticVectorCopyControl& operator=(StaticVectorCopyControl&&) noexcept = default;
+  ~StaticVectorCopyControl() = default;
+};
+
+// Vector-like container with fixed capacity N kept inline: it never allocates, and it is trivially copyable
+// whenever T is. Growing past N throws StaticVectorOverflow; At throws ArrayOutOfRange like Array.
+template <class T, size_t N>
+class StaticVector : private StaticVectorStorage<T, N>,
+                     private StaticVectorCopyControl<std::is_copy_constructible_v<T>> {
+  static_assert(N > 0, "StaticVector needs a positive capacity");
+
+ private:
+  using StaticVectorStorage<T, N>::size_;
+  using StaticVectorStorage<T, N>::Elements;
+  using StaticVectorStorage<T, N>::DestroyFrom;
+
+  void CheckCapacity(size_t n) const {
+    if (n > N) {
+      throw StaticVectorOverflow{};
+    }
+  }
+
+ public:
+  using ValueType = T;
+  using Pointer = T*;
+  using ConstPointer = const T*;
+  using Reference = T&;
+  using ConstReference = const T&;
+  using SizeType = size_t;
+  using Iterator = T*;
+  using ConstIterator = const T*;
+  using ReverseIterator = std::reverse_iterator<Iterator>;
+  using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+  static constexpr size_t kCapacity = N;
+
+  StaticVector() noexcept = default;
+
+  explicit StaticVector(size_t n) {
+    Resize(n);
+  }
+
+  StaticVector(size_t n, const T& value) {
+    Resize(n, value);
+  }
+
+  StaticVector(std::initializer_list<T> init_list) {
+    CheckCapacity(init_list.size());
+    for (const auto& value : init_list) {
+      EmplaceBack(value);
+    }
+  }
+
+  [[nodiscard]] size_t Size() const noexcept {
+    return size_;
+  }
+
+  [[nodiscard]] static constexpr size_t Capacity() noexcept {
+    return N;
+  }
+
+  [[nodiscard]] bool Empty() const noexcept {
+    return (size_ == 0);
+  }
+
+  [[nodiscard]] bool Full() const noexcept {
+    return (size_ == N);
+  }
+
+  T& operator[](size_t n) noexcept {
+    return Elements()[n];
+  }
+
+  const T& operator[](size_t n) const noexcept {
+    return Elements()[n];
+  }
+
+  T& At(size_t n) {
+    if (n >= size_) {
+      throw ArrayOutOfRange{};
+    }
+    return Elements()[n];
+  }
+
+  const T& At(size_t n) const {
+    if (n >= size_) {
+      throw ArrayOutOfRange{};
+    }
+    return Elements()[n];
+  }
+
+  T& Front() noexcept {
+    return Elements()[0];
+  }
+
+  const T& Front() const noexcept {
+    return Elements()[0];
+  }
+
+  T& Back() noexcept {
+    return Elements()[size_ - 1];
+  }
+
+  const T& Back() const noexcept {
+    return Elements()[size_ - 1];
+  }
+
+  T* Data() noexcept {
+    return Elements();
+  }
+
+  const T* Data() const noexcept {
+    return Elements();
+  }
+
+  Iterator begin() noexcept {  // NOLINT
+    return Elements();
+  }
+
+  ConstIterator begin() const noexcept {  // NOLINT
+    return Elements();
+  }
+
+  ConstIterator cbegin() const noexcept {  // NOLINT
+    return begin();
+  }
+
+  Iterator end() noexcept {  // NOLINT
+    return Elements() + size_;
+  }
+
+  ConstIterator end() const noexcept {  // NOLINT
+    return Elements() + size_;
+  }
+
+  ConstIterator cend() const noexcept {  // NOLINT
+    return end();
+  }
+
+  ReverseIterator rbegin() noexcept {  // NOLINT
+    return ReverseIterator(end());
+  }
+
+  ConstReverseIterator rbegin() const noexcept {  // NOLINT
+    return ConstReverseIterator(end());
+  }
+
+  ConstReverseIterator crbegin() const noexcept {  // NOLINT
+    return ConstReverseIterator(end());
+  }
+
+  ReverseIterator rend() noexcept {  // NOLINT
+    return ReverseIterator(begin());
+  }
+
+  ConstReverseIterator rend() const noexcept {  // NOLINT
+    return ConstReverseIterator(begin());
+  }
+
+  ConstReverseIterator crend() const noexcept {  // NOLINT
+    return ConstReverseIterator(begin());
+  }
+
+  template <class... Args>
+  T& EmplaceBack(Args&&... args) {
+    CheckCapacity(size_ + 1);
+    T* slot = ::new (static_cast<void*>(Elements() + size_)) T(std::forward<Args>(args)...);
+    ++size_;
+    return *slot;
+  }
+
+  void PushBack(const T& value) {
+    EmplaceBack(value);
+  }
+
+  void PushBack(T&& value) {
+    EmplaceBack(std::move(value));
+  }
+
+  void PopBack() noexcept {
+    if (size_ != 0) {
+      DestroyFrom(size_ - 1);
+    }
+  }
+
+  // Shifts the tail right by one; value may refer to an element of this vector.
+  template <class... Args>
+  Iterator Emplace(ConstIterator position, Args&&... args) {
+    auto index = static_cast<size_t>(position - begin());
+    CheckCapacity(size_ + 1);
+    if (index == size_) {
+      EmplaceBack(std::forward<Args>(args)...);
+      return begin() + index;
+    }
+    T value(std::forward<Args>(args)...);
+    EmplaceBack(std::move(Back()));
+    std::move_backward(begin() + index, end() - 2, end() - 1);
+    Elements()[index] = std::move(value);
+    return begin() + index;
+  }
+
+  Iterator Insert(ConstIterator position, const T& value) {
+    return Emplace(position, value);
+  }
+
+  Iterator Insert(ConstIterator position, T&& value) {
+    return Emplace(position, std::move(value));
+  }
+
+  Iterator Erase(ConstIterator first, ConstIterator last) {
+    auto index = static_cast<size_t>(first - begin());
+    auto count = static_cast<size_t>(last - first);
+    if (count != 0) {
+      std::move(begin() + index + count, end(), begin() + index);
+      DestroyFrom(size_ - count);
+    }
+    return begin() + index;
+  }
+
+  Iterator Erase(ConstIterator position) {
+    return Erase(position, position + 1);
+  }
+
+  void Resize(size_t n) {
+    CheckCapacity(n);
+    if (n < size_) {
+      DestroyFrom(n);
+    }
+    while (size_ < n) {
+      EmplaceBack();
+    }
+  }
+
+  void Resize(size_t n, const T& value) {
+    CheckCapacity(n);
+    if (n < size_) {
+      DestroyFrom(n);
+    }
+    while (size_ < n) {
+      EmplaceBack(value);
+    }
+  }
+
+  void Clear() noexcept {
+    DestroyFrom(0);
+  }
+
+  void Swap(StaticVector<T, N>& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    StaticVector<T, N> temporary(std::move(other));
+    other = std::move(*this);
+    *this = std::move(temporary);
+  }
+
+  bool operator==(const StaticVector<T, N>& other) const {
+    return std::equal(begin(), end(), other.begin(), other.end());
+  }
+
+  bool operator!=(const StaticVector<T, N>& other) const {
+    return !(*this == other);
+  }
+};
+
+#endif
@@ -0,0 +1,68 @@
+// Concurrent appends into ChunkedVector and into a std::vector guarded by a mutex.
+// Build and run from the repository root (arguments: producer threads, appends per thread; 16 and 20000 by default):
+//   g++ -std=c++17 -O2 -pthread -I. C_Vector/bench_chunked_vector.cpp -o bench_chunked_vector
+//   ./bench_chunked_vector 16 20000
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "C_Vector/chunked_vector.h"
+
+namespace {
+
+constexpr int kRepeats = 5;
+
+// Runs append(thread, i) for every i below per_thread on each of `threads` threads; returns the best wall time.
+template <class Reset, class Append>
+double BestMilliseconds(size_t threads, size_t per_thread, const Reset& reset, const Append& append) {
+  double best = 0;
+  for (int r = 0; r < kRepeats; ++r) {
+    reset();
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> producers;
+    for (size_t t = 0u; t < threads; ++t) {
+      producers.emplace_back([&append, t, per_thread] {
+        for (size_t i = 0u; i < per_thread; ++i) {
+          append(t, i);
+        }
+      });
+    }
+    for (auto& producer : producers) {
+      producer.join();
+    }
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    best = (r == 0 ? elapsed : std::min(best, elapsed));
+  }
+  return best;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  size_t threads = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 16u);
+  size_t per_thread = (argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000u);
+
+  ChunkedVector<uint64_t> chunked;
+  double chunked_ms = BestMilliseconds(
+      threads, per_thread, [&] { chunked.Clear(); },
+      [&](size_t t, size_t i) { chunked.PushBack(t * per_thread + i); });
+
+  std::mutex mutex;
+  std::vector<uint64_t> locked;
+  double locked_ms = BestMilliseconds(
+      threads, per_thread, [&] { locked = std::vector<uint64_t>(); },
+      [&](size_t t, size_t i) {
+        std::lock_guard<std::mutex> lock(mutex);
+        locked.push_back(t * per_thread + i);
+      });
+
+  std::printf("%zu producers x %zu appends (%u hardware threads), best of %d\n", threads, per_thread,
+              std::thread::hardware_concurrency(), kRepeats);
+  std::printf("ChunkedVector             %8.2f ms   (size %zu)\n", chunked_ms, chunked.Size());
+  std::printf("mutex + std::vector       %8.2f ms   (size %zu)\n", locked_ms, locked.size());
+  return 0;
+}
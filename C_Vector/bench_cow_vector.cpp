@@ -0,0 +1,80 @@
+// Read-mostly fan-out: one large vector handed to many consumers as a deep-copied Vector and as a shared
+// CowVector, with consumers that only read and with one in eight that writes once.
+// Build and run from the repository root (arguments: elements, consumers; 1M and 64 by default):
+//   g++ -std=c++17 -O2 -pthread -I. C_Vector/bench_cow_vector.cpp -o bench_cow_vector && ./bench_cow_vector
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "C_Vector/cow_vector.h"
+#include "C_Vector/vector.h"
+
+namespace {
+
+constexpr size_t kReaderThreads = 4;
+constexpr size_t kWriterEvery = 8;
+
+// A consumer sums its copy, first changing one element of it if it is a writer.
+template <class Container>
+double Consume(Container copy, bool writes) {
+  if (writes) {
+    copy[0] = 1;
+  }
+  const Container& view = copy;
+  double sum = 0;
+  for (size_t i = 0u; i < view.Size(); ++i) {
+    sum += view[i];
+  }
+  return sum;
+}
+
+// Hands `source` to `consumers` consumers spread over kReaderThreads threads, every kWriterEvery-th of them a
+// writer if with_writers is set; returns milliseconds.
+template <class Container>
+double FanOut(const Container& source, size_t consumers, bool with_writers, double& checksum) {
+  std::vector<double> sums(kReaderThreads);
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (size_t t = 0u; t < kReaderThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (size_t c = t; c < consumers; c += kReaderThreads) {
+        sums[t] += Consume<Container>(source, with_writers && c % kWriterEvery == 0);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  for (double sum : sums) {
+    checksum += sum;
+  }
+  return elapsed;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  size_t n = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000u);
+  size_t consumers = (argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64u);
+
+  Vector<double> deep(n);
+  for (size_t i = 0u; i < n; ++i) {
+    deep[i] = static_cast<double>(i % 1000);
+  }
+  const CowVector<double> shared(deep);
+
+  double checksum = 0;
+  std::printf("%zu doubles to %zu consumers on %zu threads (milliseconds)\n", n, consumers, kReaderThreads);
+  std::printf("%-24s %12s %12s\n", "", "read only", "1/8 write");
+  double deep_read = FanOut(deep, consumers, false, checksum);
+  double deep_write = FanOut(deep, consumers, true, checksum);
+  std::printf("%-24s %12.2f %12.2f\n", "Vector (deep copy)", deep_read, deep_write);
+  double cow_read = FanOut(shared, consumers, false, checksum);
+  double cow_write = FanOut(shared, consumers, true, checksum);
+  std::printf("%-24s %12.2f %12.2f\n", "CowVector (shared)", cow_read, cow_write);
+  std::printf("(checksum %g)\n", checksum);
+  return 0;
+}
@@ -0,0 +1,89 @@
+// Single-field and two-field scans over 64-byte records stored as Vector<Record> and as SoaVector.
+// Build and run from the repository root (the argument is the number of records, 4M by default):
+//   g++ -std=c++17 -O2 -I. C_Vector/bench_soa_vector.cpp -o bench_soa_vector && ./bench_soa_vector 4000000
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "C_Vector/soa_vector.h"
+#include "C_Vector/vector.h"
+
+namespace {
+
+constexpr int kRepeats = 10;
+
+struct Record {
+  double price;
+  double quantity;
+  int64_t id;
+  int64_t timestamp;
+  double bid;
+  double ask;
+  int64_t flags;
+  int64_t venue;
+};
+
+using Columns = SoaVector<double, double, int64_t, int64_t, double, double, int64_t, int64_t>;
+
+template <class Function>
+double MillisecondsPerRun(const Function& function) {
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < kRepeats; ++r) {
+    function();
+  }
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count() / kRepeats;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  size_t n = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000u);
+  Vector<Record> rows;
+  Columns columns;
+  for (size_t i = 0u; i < n; ++i) {
+    auto x = static_cast<double>(i % 1000);
+    auto k = static_cast<int64_t>(i);
+    rows.PushBack(Record{x, x + 1, k, k, x, x, 0, 0});
+    columns.EmplaceBack(x, x + 1, k, k, x, x, int64_t{0}, int64_t{0});
+  }
+
+  volatile double sink = 0;
+  double aos_one = MillisecondsPerRun([&] {
+    double sum = 0;
+    for (const Record& row : rows) {
+      sum += row.price;
+    }
+    sink = sum;
+  });
+  double soa_one = MillisecondsPerRun([&] {
+    const double* price = columns.Data<0>();
+    double sum = 0;
+    for (size_t i = 0u; i < columns.Size(); ++i) {
+      sum += price[i];
+    }
+    sink = sum;
+  });
+  double aos_two = MillisecondsPerRun([&] {
+    double sum = 0;
+    for (const Record& row : rows) {
+      sum += row.price * row.quantity;
+    }
+    sink = sum;
+  });
+  double soa_two = MillisecondsPerRun([&] {
+    const double* price = columns.Data<0>();
+    const double* quantity = columns.Data<1>();
+    double sum = 0;
+    for (size_t i = 0u; i < columns.Size(); ++i) {
+      sum += price[i] * quantity[i];
+    }
+    sink = sum;
+  });
+
+  std::printf("%zu records of %zu bytes, mean of %d scans\n", n, sizeof(Record), kRepeats);
+  std::printf("sum(price)            Vector<Record> %8.2f ms   SoaVector %8.2f ms\n", aos_one, soa_one);
+  std::printf("sum(price * quantity) Vector<Record> %8.2f ms   SoaVector %8.2f ms\n", aos_two, soa_two);
+  return (sink < 0 ? 1 : 0);
+}
@@ -0,0 +1,303 @@
+#ifndef LARGETASKS_CHUNKED_VECTOR_H
+#define LARGETASKS_CHUNKED_VECTOR_H
+
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <climits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Append-only sequence stored in power-of-two chunks that never move, so references and pointers to elements stay
+// valid for the lifetime of the container. Chunk k holds 2^(kFirstChunkBits + k) elements; doubling the chunk size
+// lets a fixed directory of kDirectorySize atomic chunk pointers cover the whole size_t range without ever being
+// reallocated itself. Each chunk carries one ready flag per slot after its elements.
+//
+// PushBack and EmplaceBack may be called from any number of threads at once and never wait for one another: a
+// producer claims a slot with one fetch_add on the reserved size, installs a missing chunk with a compare-exchange,
+// builds the element in place and sets the slot's ready flag. It then advances the published size over every
+// ready slot it finds, so Size() is the longest prefix of built elements; a slot left unready by a slow producer
+// only delays the visibility of later slots, never their producers. operator[] on an index below Size() is
+// wait-free, and IsPublished tells whether any single slot is ready. Elements are built from a local copy before a
+// slot is claimed, so a throwing constructor never leaves a hole; a failure to allocate a chunk after claiming a
+// slot terminates. Clear, Swap, assignment and destruction require exclusive access.
+template <class T, size_t kFirstChunkBits = 8>
+class ChunkedVector {
+  static_assert(std::is_nothrow_move_constructible_v<T>, "ChunkedVector elements must be nothrow-movable");
+  static_assert(kFirstChunkBits < sizeof(size_t) * CHAR_BIT, "ChunkedVector first chunk is too large");
+
+ public:
+  using ValueType = T;
+  using Pointer = T*;
+  using ConstPointer = const T*;
+  using Reference = T&;
+  using ConstReference = const T&;
+  using SizeType = size_t;
+
+  static constexpr size_t kFirstChunkSize = size_t{1} << kFirstChunkBits;
+  static constexpr size_t kDirectorySize = sizeof(size_t) * CHAR_BIT - kFirstChunkBits;
+
+ private:
+  static constexpr size_t kCacheLineSize = 64;
+
+  std::array<std::atomic<T*>, kDirectorySize> chunks_{};
+  alignas(kCacheLineSize) std::atomic<size_t> reserved_{0};
+  alignas(kCacheLineSize) std::atomic<size_t> published_{0};
+
+  static size_t ChunkIndex(size_t n) noexcept {
+    size_t blocks = (n >> kFirstChunkBits) + 1;
+    size_t index = 0;
+    while (blocks >>= 1u) {
+      ++index;
+    }
+    return index;
+  }
+
+  static size_t ChunkBegin(size_t chunk) noexcept {
+    return ((size_t{1} << chunk) - 1) << kFirstChunkBits;
+  }
+
+  static size_t ChunkSize(size_t chunk) noexcept {
+    return kFirstChunkSize << chunk;
+  }
+
+  T* Slot(size_t n) const noexcept {
+    size_t chunk = ChunkIndex(n);
+    return chunks_[chunk].load(std::memory_order_acquire) + (n - ChunkBegin(chunk));
+  }
+
+  // The ready flags of chunk `chunk` follow its elements in the same allocation.
+  static std::atomic<bool>* ReadyFlags(T* pointer, size_t chunk) noexcept {
+    return std::launder(reinterpret_cast<std::atomic<bool>*>(pointer + ChunkSize(chunk)));
+  }
+
+  static size_t ChunkBytes(size_t chunk) noexcept {
+    return ChunkSize(chunk) * (sizeof(T) + sizeof(std::atomic<bool>));
+  }
+
+  // Returns chunk `chunk`, allocating it if needed; when producers race, the loser frees its allocation.
+  T* EnsureChunk(size_t chunk) {
+    T* pointer = chunks_[chunk].load(std::memory_order_acquire);
+    if (pointer != nullptr) {
+      return pointer;
+    }
+    auto* fresh = static_cast<T*>(::operator new(ChunkBytes(chunk), std::align_val_t{alignof(T)}));
+    auto* flags = reinterpret_cast<unsigned char*>(fresh + ChunkSize(chunk));
+    for (size_t i = 0u; i < ChunkSize(chunk); ++i) {
+      ::new (static_cast<void*>(flags + i * sizeof(std::atomic<bool>))) std::atomic<bool>(false);
+    }
+    if (chunks_[chunk].compare_exchange_strong(pointer, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+      return fresh;
+    }
+    ::operator delete(fresh, std::align_val_t{alignof(T)});
+    return pointer;
+  }
+
+  // Advances published_ over the ready slots that follow it. The flag store in Append and the loads here are
+  // sequentially consistent, so either the producer of a slot or the thread that published its predecessor sees
+  // the slot ready and publishes it.
+  void Publish() noexcept {
+    size_t published = published_.load();
+    for (;;) {
+      size_t chunk = ChunkIndex(published);
+      T* pointer = chunks_[chunk].load();
+      if (pointer == nullptr || !ReadyFlags(pointer, chunk)[published - ChunkBegin(chunk)].load()) {
+        return;
+      }
+      if (published_.compare_exchange_weak(published, published + 1)) {
+        ++published;
+      }
+    }
+  }
+
+  T& Append(T&& value) noexcept {
+    size_t n = reserved_.fetch_add(1, std::memory_order_relaxed);
+    size_t chunk = ChunkIndex(n);
+    T* pointer = EnsureChunk(chunk);
+    T* slot = pointer + (n - ChunkBegin(chunk));
+    ::new (static_cast<void*>(slot)) T(std::move(value));
+    ReadyFlags(pointer, chunk)[n - ChunkBegin(chunk)].store(true);
+    Publish();
+    return *slot;
+  }
+
+  // Destroys every element and clears its ready flag; with exclusive access every claimed slot is published.
+  void DestroyElements() noexcept {
+    size_t size = published_.load(std::memory_order_relaxed);
+    for (size_t chunk = 0u; chunk < kDirectorySize && ChunkBegin(chunk) < size; ++chunk) {
+      T* pointer = chunks_[chunk].load(std::memory_order_relaxed);
+      size_t count = std::min(ChunkSize(chunk), size - ChunkBegin(chunk));
+      if constexpr (!std::is_trivially_destructible_v<T>) {
+        std::destroy_n(pointer, count);
+      }
+      std::atomic<bool>* flags = ReadyFlags(pointer, chunk);
+      for (size_t i = 0u; i < count; ++i) {
+        flags[i].store(false, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void DeallocateChunks() noexcept {
+    for (auto& chunk : chunks_) {
+      T* pointer = chunk.exchange(nullptr, std::memory_order_relaxed);
+      if (pointer != nullptr) {
+        ::operator delete(pointer, std::align_val_t{alignof(T)});
+      }
+    }
+  }
+
+ public:
+  ChunkedVector() noexcept = default;
+
+  ChunkedVector(const ChunkedVector<T, kFirstChunkBits>& other) : ChunkedVector() {
+    try {
+      for (size_t i = 0u; i < other.Size(); ++i) {
+        PushBack(other[i]);
+      }
+    } catch (...) {
+      DestroyElements();
+      DeallocateChunks();
+      throw;
+    }
+  }
+
+  ChunkedVector<T, kFirstChunkBits>& operator=(const ChunkedVector<T, kFirstChunkBits>& other) {
+    if (this != &other) {
+      ChunkedVector<T, kFirstChunkBits> copy(other);
+      Swap(copy);
+    }
+    return *this;
+  }
+
+  ChunkedVector(ChunkedVector<T, kFirstChunkBits>&& rvalue_vector) noexcept {
+    Swap(rvalue_vector);
+  }
+
+  ChunkedVector<T, kFirstChunkBits>& operator=(ChunkedVector<T, kFirstChunkBits>&& rvalue_vector) noexcept {
+    if (this != &rvalue_vector) {
+      Clear();
+      DeallocateChunks();
+      Swap(rvalue_vector);
+    }
+    return *this;
+  }
+
+  // Number of published elements; every index below it may be read.
+  [[nodiscard]] size_t Size() const noexcept {
+    return published_.load(std::memory_order_acquire);
+  }
+
+  [[nodiscard]] bool Empty() const noexcept {
+    return (Size() == 0);
+  }
+
+  // Whether slot n holds a built element, even if an earlier slot is still being built.
+  [[nodiscard]] bool IsPublished(size_t n) const noexcept {
+    if (n < Size()) {
+      return true;
+    }
+    size_t chunk = ChunkIndex(n);
+    T* pointer = chunks_[chunk].load(std::memory_order_acquire);
+    return (pointer != nullptr && ReadyFlags(pointer, chunk)[n - ChunkBegin(chunk)].load(std::memory_order_acquire));
+  }
+
+  [[nodiscard]] size_t Capacity() const noexcept {
+    size_t capacity = 0;
+    for (size_t chunk = 0u; chunk < kDirectorySize; ++chunk) {
+      if (chunks_[chunk].load(std::memory_order_acquire) == nullptr) {
+        break;
+      }
+      capacity = ChunkBegin(chunk) + ChunkSize(chunk);
+    }
+    return capacity;
+  }
+
+  T& operator[](size_t n) noexcept {
+    return *Slot(n);
+  }
+
+  const T& operator[](size_t n) const noexcept {
+    return *Slot(n);
+  }
+
+  T& At(size_t n) {
+    if (n >= Size()) {
+      throw std::out_of_range("");
+    }
+    return *Slot(n);
+  }
+
+  const T& At(size_t n) const {
+    if (n >= Size()) {
+      throw std::out_of_range("");
+    }
+    return *Slot(n);
+  }
+
+  T& Front() noexcept {
+    return *Slot(0);
+  }
+
+  const T& Front() const noexcept {
+    return *Slot(0);
+  }
+
+  T& Back() noexcept {
+    return *Slot(Size() - 1);
+  }
+
+  const T& Back() const noexcept {
+    return *Slot(Size() - 1);
+  }
+
+  // Returns a reference to the new element, which stays valid until Clear or destruction.
+  template <class... Args>
+  T& EmplaceBack(Args&&... args) {
+    return Append(T(std::forward<Args>(args)...));
+  }
+
+  T& PushBack(const T& value) {
+    return Append(T(value));
+  }
+
+  T& PushBack(T&& value) {
+    return Append(std::move(value));
+  }
+
+  // Allocates the chunks needed for n elements up front; safe to call concurrently with PushBack.
+  void Reserve(size_t n) {
+    for (size_t chunk = 0u; chunk < kDirectorySize && ChunkBegin(chunk) < n; ++chunk) {
+      EnsureChunk(chunk);
+    }
+  }
+
+  // Keeps the chunks for reuse.
+  void Clear() noexcept {
+    DestroyElements();
+    reserved_.store(0, std::memory_order_relaxed);
+    published_.store(0, std::memory_order_release);
+  }
+
+  void Swap(ChunkedVector<T, kFirstChunkBits>& other) noexcept {
+    for (size_t chunk = 0u; chunk < kDirectorySize; ++chunk) {
+      T* pointer = chunks_[chunk].load(std::memory_order_relaxed);
+      chunks_[chunk].store(other.chunks_[chunk].exchange(pointer, std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+    }
+    reserved_.store(other.reserved_.exchange(reserved_.load(std::memory_order_relaxed), std::memory_order_relaxed),
+                    std::memory_order_relaxed);
+    published_.store(other.published_.exchange(published_.load(std::memory_order_relaxed), std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+  }
+
+  ~ChunkedVector() noexcept {
+    DestroyElements();
+    DeallocateChunks();
+  }
+};
+
+#endif
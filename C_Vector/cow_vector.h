@@ -0,0 +1,283 @@
+#ifndef LARGETASKS_COW_VECTOR_H
+#define LARGETASKS_COW_VECTOR_H
+
+#include <cstdint>
+#include <atomic>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "vector.h"
+
+// Copy-on-write Vector for read-mostly fan-out: copies share one reference-counted buffer, and the first mutation
+// through a shared copy clones it. The count is atomic, so copies may be read concurrently from several threads;
+// a single CowVector object still must not be mutated concurrently.
+//
+// Non-const element access (operator[], At, Front, Back, Data, begin/end) hands out a writable reference, so it
+// also marks the buffer unshareable: later copies of that object are deep, and such references never leak into
+// a copy. The growth API only detaches and keeps the buffer shareable.
+template <class T>
+class CowVector {
+ public:
+  using ValueType = T;
+  using Pointer = T*;
+  using ConstPointer = const T*;
+  using Reference = T&;
+  using ConstReference = const T&;
+  using SizeType = size_t;
+  using Iterator = T*;
+  using ConstIterator = const T*;
+  using ReverseIterator = std::reverse_iterator<Iterator>;
+  using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+ private:
+  struct Buffer {
+    std::atomic<size_t> references_{1};
+    bool shareable_ = true;
+    Vector<T> elements_;
+
+    Buffer() = default;
+
+    explicit Buffer(Vector<T> elements) : elements_(std::move(elements)) {
+    }
+  };
+
+  Buffer* buffer_ = nullptr;
+
+  void Release() noexcept {
+    if (buffer_ != nullptr && buffer_->references_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete buffer_;
+    }
+    buffer_ = nullptr;
+  }
+
+  // Makes this the sole owner of its buffer, cloning the elements if another copy still shares them.
+  Vector<T>& Detach() {
+    if (buffer_ == nullptr) {
+      buffer_ = new Buffer();
+    } else if (buffer_->references_.load(std::memory_order_acquire) != 1) {
+      auto* clone = new Buffer(buffer_->elements_);
+      Release();
+      buffer_ = clone;
+    }
+    return buffer_->elements_;
+  }
+
+  Vector<T>& DetachUnshareable() {
+    Vector<T>& elements = Detach();
+    buffer_->shareable_ = false;
+    return elements;
+  }
+
+ public:
+  CowVector() noexcept = default;
+
+  explicit CowVector(size_t n) : buffer_(new Buffer(Vector<T>(n))) {
+  }
+
+  CowVector(size_t n, const T& value) : buffer_(new Buffer(Vector<T>(n, value))) {
+  }
+
+  template <class ForwardIt,
+            class = std::enable_if_t<std::is_base_of_v<std::forward_iterator_tag,
+                                                       typename std::iterator_traits<ForwardIt>::iterator_category>>>
+  CowVector(ForwardIt begin, ForwardIt end) : buffer_(new Buffer(Vector<T>(begin, end))) {
+  }
+
+  CowVector(std::initializer_list<T> init_list) : buffer_(new Buffer(Vector<T>(init_list))) {
+  }
+
+  explicit CowVector(Vector<T> elements) : buffer_(new Buffer(std::move(elements))) {
+  }
+
+  CowVector(const CowVector<T>& other) {
+    if (other.buffer_ == nullptr) {
+      return;
+    }
+    if (other.buffer_->shareable_) {
+      other.buffer_->references_.fetch_add(1, std::memory_order_relaxed);
+      buffer_ = other.buffer_;
+    } else {
+      buffer_ = new Buffer(other.buffer_->elements_);
+    }
+  }
+
+  CowVector<T>& operator=(const CowVector<T>& other) {
+    if (this != &other) {
+      CowVector<T> copy(other);
+      Swap(copy);
+    }
+    return *this;
+  }
+
+  CowVector(CowVector<T>&& rvalue_vector) noexcept : buffer_(std::exchange(rvalue_vector.buffer_, nullptr)) {
+  }
+
+  CowVector<T>& operator=(CowVector<T>&& rvalue_vector) noexcept {
+    if (this != &rvalue_vector) {
+      Release();
+      buffer_ = std::exchange(rvalue_vector.buffer_, nullptr);
+    }
+    return *this;
+  }
+
+  [[nodiscard]] size_t UseCount() const noexcept {
+    return (buffer_ == nullptr ? 0 : buffer_->references_.load(std::memory_order_relaxed));
+  }
+
+  [[nodiscard]] size_t Size() const noexcept {
+    return (buffer_ == nullptr ? 0 : buffer_->elements_.Size());
+  }
+
+  [[nodiscard]] size_t Capacity() const noexcept {
+    return (buffer_ == nullptr ? 0 : buffer_->elements_.Capacity());
+  }
+
+  [[nodiscard]] bool Empty() const noexcept {
+    return (Size() == 0);
+  }
+
+  const T& operator[](size_t n) const {
+    return buffer_->elements_[n];
+  }
+
+  T& operator[](size_t n) {
+    return DetachUnshareable()[n];
+  }
+
+  const T& At(size_t n) const {
+    if (n >= Size()) {
+      throw std::out_of_range("");
+    }
+    return buffer_->elements_[n];
+  }
+
+  T& At(size_t n) {
+    if (n >= Size()) {
+      throw std::out_of_range("");
+    }
+    return DetachUnshareable()[n];
+  }
+
+  const T& Back() const noexcept {
+    return buffer_->elements_.Back();
+  }
+
+  T& Back() {
+    return DetachUnshareable().Back();
+  }
+
+  const T& Front() const noexcept {
+    return buffer_->elements_.Front();
+  }
+
+  T& Front() {
+    return DetachUnshareable().Front();
+  }
+
+  const T* Data() const noexcept {
+    return (buffer_ == nullptr ? nullptr : buffer_->elements_.Data());
+  }
+
+  T* Data() {
+    return DetachUnshareable().Data();
+  }
+
+  Iterator begin() {  // NOLINT
+    return DetachUnshareable().begin();
+  }
+
+  ConstIterator begin() const noexcept {  // NOLINT
+    return (buffer_ == nullptr ? nullptr : buffer_->elements_.begin());
+  }
+
+  ConstIterator cbegin() const noexcept {  // NOLINT
+    return begin();
+  }
+
+  Iterator end() {  // NOLINT
+    return DetachUnshareable().end();
+  }
+
+  ConstIterator end() const noexcept {  // NOLINT
+    return (buffer_ == nullptr ? nullptr : buffer_->elements_.end());
+  }
+
+  ConstIterator cend() const noexcept {  // NOLINT
+    return end();
+  }
+
+  ReverseIterator rbegin() {  // NOLINT
+    return ReverseIterator(end());
+  }
+
+  ConstReverseIterator rbegin() const noexcept {  // NOLINT
+    return ConstReverseIterator(end());
+  }
+
+  ConstReverseIterator crbegin() const noexcept {  // NOLINT
+    return ConstReverseIterator(end());
+  }
+
+  ReverseIterator rend() {  // NOLINT
+    return ReverseIterator(begin());
+  }
+
+  ConstReverseIterator rend() const noexcept {  // NOLINT
+    return ConstReverseIterator(begin());
+  }
+
+  ConstReverseIterator crend() const noexcept {  // NOLINT
+    return ConstReverseIterator(begin());
+  }
+
+  template <class... Args>
+  void EmplaceBack(Args&&... args) {
+    Detach().EmplaceBack(std::forward<Args>(args)...);
+  }
+
+  void PushBack(const T& value) {
+    Detach().PushBack(value);
+  }
+
+  void PushBack(T&& value) {
+    Detach().PushBack(std::move(value));
+  }
+
+  void PopBack() {
+    Detach().PopBack();
+  }
+
+  void Reserve(size_t n) {
+    Detach().Reserve(n);
+  }
+
+  void Resize(size_t n) {
+    Detach().Resize(n);
+  }
+
+  void Resize(size_t n, const T& value) {
+    Detach().Resize(n, value);
+  }
+
+  // Drops this copy's reference instead of cloning a buffer only to empty it.
+  void Clear() noexcept {
+    Release();
+  }
+
+  void ShrinkToFit() {
+    Detach().ShrinkToFit();
+  }
+
+  void Swap(CowVector<T>& other) noexcept {
+    std::swap(buffer_, other.buffer_);
+  }
+
+  ~CowVector() noexcept {
+    Release();
+  }
+};
+
+#endif
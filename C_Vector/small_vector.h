@@ -0,0 +1,399 @@
+#ifndef LARGETASKS_SMALL_VECTOR_H
+#define LARGETASKS_SMALL_VECTOR_H
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <memory>
+#include <new>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+
+#include "vector_storage.h"
+
+// Vector with the same interface that keeps up to K elements in an inline buffer and only goes to the heap once
+// it outgrows it. Unlike Vector, moving or swapping an inline SmallVector moves its elements one by one.
+template <class T, size_t K = 8>
+class SmallVector {
+ public:
+  using ValueType = T;
+  using Pointer = T*;
+  using ConstPointer = const T*;
+  using Reference = T&;
+  using ConstReference = const T&;
+  using SizeType = size_t;
+  using Iterator = T*;
+  using ConstIterator = const T*;
+  using ReverseIterator = std::reverse_iterator<Iterator>;
+  using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+  static constexpr size_t kInlineCapacity = K;
+
+ private:
+  using Storage = VectorStorage<T, std::allocator<T>>;
+
+  static constexpr size_t kGrowthFactor = 2;
+
+  // Stateless; elements are built and destroyed through it exactly as with placement new.
+  static inline std::allocator<T> allocator_{};
+
+  T* data_ = InlineData();
+  size_t n_elements_ = 0;
+  size_t capacity_ = K;
+  alignas(T) unsigned char inline_buffer_[(K == 0 ? 1 : K) * sizeof(T)];
+
+  T* InlineData() noexcept {
+    return reinterpret_cast<T*>(inline_buffer_);
+  }
+
+  [[nodiscard]] bool IsInline() const noexcept {
+    return data_ == reinterpret_cast<const T*>(inline_buffer_);
+  }
+
+  static T* AllocateStorage(size_t n) {
+    return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignof(T)}));
+  }
+
+  static void DeallocateStorage(T* data) noexcept {
+    ::operator delete(data, std::align_val_t{alignof(T)});
+  }
+
+  static void DestroyRange(T* first, T* last) noexcept {
+    Storage::DestroyRange(allocator_, first, last);
+  }
+
+  static void ValueConstruct(T* first, size_t n) {
+    Storage::ValueConstruct(allocator_, first, n);
+  }
+
+  static void FillConstruct(T* first, size_t n, const T& value) {
+    Storage::FillConstruct(allocator_, first, n, value);
+  }
+
+  static void RelocateRange(T* source, size_t n, T* target) {
+    Storage::RelocateRange(allocator_, source, n, target);
+  }
+
+  void ReleaseStorage() noexcept {
+    DestroyRange(data_, data_ + n_elements_);
+    if (!IsInline()) {
+      DeallocateStorage(data_);
+    }
+    data_ = InlineData();
+    n_elements_ = 0;
+    capacity_ = K;
+  }
+
+  [[nodiscard]] size_t GrownCapacity(size_t required) const noexcept {
+    return std::max(required, capacity_ * kGrowthFactor);
+  }
+
+  // Same contract as Vector::Reallocate; a capacity of at most K moves the elements back inline.
+  template <class ConstructNewSlots>
+  void Reallocate(size_t new_capacity, size_t n_new, const ConstructNewSlots& construct_new_slots) {
+    bool to_inline = new_capacity <= K;
+    T* new_data = (to_inline ? InlineData() : AllocateStorage(new_capacity));
+    try {
+      Storage::RelocateWithNewSlots(allocator_, data_, n_elements_, new_data, n_new, construct_new_slots);
+    } catch (...) {
+      if (!to_inline) {
+        DeallocateStorage(new_data);
+      }
+      throw;
+    }
+    DestroyRange(data_, data_ + n_elements_);
+    if (!IsInline()) {
+      DeallocateStorage(data_);
+    }
+    data_ = new_data;
+    capacity_ = (to_inline ? K : new_capacity);
+  }
+
+  template <class ConstructTail>
+  void ResizeWith(size_t n, const ConstructTail& construct_tail) {
+    Storage::Resize(allocator_, data_, n_elements_, capacity_, n,
+                    [&](size_t n_new, const auto& construct_new_slots) {
+                      Reallocate(GrownCapacity(n), n_new, construct_new_slots);
+                    },
+                    construct_tail);
+    n_elements_ = n;
+  }
+
+  // Moves the inline elements of `from` into the empty inline buffer of `to`.
+  static void MoveInlineElements(SmallVector<T, K>& from, SmallVector<T, K>& to) {
+    RelocateRange(from.data_, from.n_elements_, to.InlineData());
+    to.data_ = to.InlineData();
+    to.n_elements_ = from.n_elements_;
+    to.capacity_ = K;
+    DestroyRange(from.data_, from.data_ + from.n_elements_);
+    from.n_elements_ = 0;
+  }
+
+ public:
+  SmallVector() noexcept {
+  }
+
+  explicit SmallVector(size_t n) {
+    Resize(n);
+  }
+
+  SmallVector(size_t n, const T& value) {
+    Resize(n, value);
+  }
+
+  template <class ForwardIt,
+            class = std::enable_if_t<std::is_base_of_v<std::forward_iterator_tag,
+                                                       typename std::iterator_traits<ForwardIt>::iterator_category>>>
+  SmallVector(ForwardIt begin, ForwardIt end) {
+    size_t n = static_cast<size_t>(std::distance(begin, end));
+    Reserve(n);
+    try {
+      ForwardIt it = begin;
+      Storage::ConstructRange(allocator_, data_, n, [&it](T* slot, size_t) {
+        ::new (static_cast<void*>(slot)) T(*it);
+        ++it;
+      });
+    } catch (...) {
+      ReleaseStorage();
+      throw;
+    }
+    n_elements_ = n;
+  }
+
+  SmallVector(std::initializer_list<T> init_list) : SmallVector(init_list.begin(), init_list.end()) {
+  }
+
+  SmallVector(const SmallVector<T, K>& other) : SmallVector(other.data_, other.data_ + other.n_elements_) {
+  }
+
+  SmallVector<T, K>& operator=(const SmallVector<T, K>& other) {
+    if (this != &other) {
+      SmallVector<T, K> copy(other);
+      Swap(copy);
+    }
+    return *this;
+  }
+
+  SmallVector(SmallVector<T, K>&& rvalue_vector) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    if (rvalue_vector.IsInline()) {
+      MoveInlineElements(rvalue_vector, *this);
+    } else {
+      data_ = std::exchange(rvalue_vector.data_, rvalue_vector.InlineData());
+      n_elements_ = std::exchange(rvalue_vector.n_elements_, 0);
+      capacity_ = std::exchange(rvalue_vector.capacity_, K);
+    }
+  }
+
+  SmallVector<T, K>& operator=(SmallVector<T, K>&& rvalue_vector) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    if (this != &rvalue_vector) {
+      ReleaseStorage();
+      SmallVector<T, K> moved(std::move(rvalue_vector));
+      Swap(moved);
+    }
+    return *this;
+  }
+
+  [[nodiscard]] size_t Size() const noexcept {
+    return n_elements_;
+  }
+
+  [[nodiscard]] size_t Capacity() const noexcept {
+    return capacity_;
+  }
+
+  [[nodiscard]] bool Empty() const noexcept {
+    return (n_elements_ == 0);
+  }
+
+  [[nodiscard]] bool IsSmall() const noexcept {
+    return IsInline();
+  }
+
+  const T& operator[](size_t n) const {
+    return data_[n];
+  }
+
+  T& operator[](size_t n) {
+    return data_[n];
+  }
+
+  const T& At(size_t n) const {
+    if (n >= n_elements_) {
+      throw std::out_of_range("");
+    }
+    return data_[n];
+  }
+
+  T& At(size_t n) {
+    if (n >= n_elements_) {
+      throw std::out_of_range("");
+    }
+    return data_[n];
+  }
+
+  const T& Back() const noexcept {
+    return data_[n_elements_ - 1];
+  }
+
+  T& Back() noexcept {
+    return data_[n_elements_ - 1];
+  }
+
+  const T& Front() const noexcept {
+    return data_[0];
+  }
+
+  T& Front() noexcept {
+    return data_[0];
+  }
+
+  const T* Data() const noexcept {
+    return (n_elements_ == 0 ? nullptr : data_);
+  }
+
+  T* Data() noexcept {
+    return (n_elements_ == 0 ? nullptr : data_);
+  }
+
+  // Plain pointers: contiguous iterators usable with STL algorithms, execution policies and ranges.
+  Iterator begin() noexcept {  // NOLINT
+    return data_;
+  }
+
+  ConstIterator begin() const noexcept {  // NOLINT
+    return data_;
+  }
+
+  ConstIterator cbegin() const noexcept {  // NOLINT
+    return data_;
+  }
+
+  Iterator end() noexcept {  // NOLINT
+    return data_ + n_elements_;
+  }
+
+  ConstIterator end() const noexcept {  // NOLINT
+    return data_ + n_elements_;
+  }
+
+  ConstIterator cend() const noexcept {  // NOLINT
+    return data_ + n_elements_;
+  }
+
+  ReverseIterator rbegin() noexcept {  // NOLINT
+    return ReverseIterator(end());
+  }
+
+  ConstReverseIterator rbegin() const noexcept {  // NOLINT
+    return ConstReverseIterator(end());
+  }
+
+  ConstReverseIterator crbegin() const noexcept {  // NOLINT
+    return ConstReverseIterator(end());
+  }
+
+  ReverseIterator rend() noexcept {  // NOLINT
+    return ReverseIterator(begin());
+  }
+
+  ConstReverseIterator rend() const noexcept {  // NOLINT
+    return ConstReverseIterator(begin());
+  }
+
+  ConstReverseIterator crend() const noexcept {  // NOLINT
+    return ConstReverseIterator(begin());
+  }
+
+  template <class... Args>
+  T& EmplaceBack(Args&&... args) {
+    if (n_elements_ == capacity_) {
+      Reallocate(GrownCapacity(n_elements_ + 1), 1u,
+                 [&](T* slot) { ::new (static_cast<void*>(slot)) T(std::forward<Args>(args)...); });
+    } else {
+      ::new (static_cast<void*>(data_ + n_elements_)) T(std::forward<Args>(args)...);
+    }
+    return data_[n_elements_++];
+  }
+
+  void PushBack(const T& value) {
+    EmplaceBack(value);
+  }
+
+  void PushBack(T&& value) {
+    EmplaceBack(std::move(value));
+  }
+
+  void PopBack() noexcept {
+    if (n_elements_ != 0) {
+      --n_elements_;
+      DestroyRange(data_ + n_elements_, data_ + n_elements_ + 1);
+    }
+  }
+
+  void Reserve(size_t n) {
+    if (n > capacity_) {
+      Reallocate(n, 0u, [](T*) {});
+    }
+  }
+
+  void Resize(size_t n) {
+    ResizeWith(n, [](T* first, size_t count) { ValueConstruct(first, count); });
+  }
+
+  void Resize(size_t n, const T& value) {
+    ResizeWith(n, [&value](T* first, size_t count) { FillConstruct(first, count, value); });
+  }
+
+  void Clear() noexcept {
+    DestroyRange(data_, data_ + n_elements_);
+    n_elements_ = 0;
+  }
+
+  void ShrinkToFit() {
+    if (!IsInline() && capacity_ > n_elements_) {
+      Reallocate(n_elements_, 0u, [](T*) {});
+    }
+  }
+
+  void Swap(SmallVector<T, K>& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    if (this == &other) {
+      return;
+    }
+    if (!IsInline() && !other.IsInline()) {
+      std::swap(data_, other.data_);
+      std::swap(n_elements_, other.n_elements_);
+      std::swap(capacity_, other.capacity_);
+    } else if (!IsInline() || !other.IsInline()) {
+      SmallVector<T, K>& heap_owner = (IsInline() ? other : *this);
+      SmallVector<T, K>& inline_owner = (IsInline() ? *this : other);
+      T* heap_data = heap_owner.data_;
+      size_t heap_size = heap_owner.n_elements_;
+      size_t heap_capacity = heap_owner.capacity_;
+      // Relocating into the heap owner's unused inline buffer touches neither vector until it succeeds.
+      MoveInlineElements(inline_owner, heap_owner);
+      inline_owner.data_ = heap_data;
+      inline_owner.n_elements_ = heap_size;
+      inline_owner.capacity_ = heap_capacity;
+    } else {
+      SmallVector<T, K>& longer = (n_elements_ >= other.n_elements_ ? *this : other);
+      SmallVector<T, K>& shorter = (n_elements_ >= other.n_elements_ ? other : *this);
+      using std::swap;
+      for (size_t i = 0u; i < shorter.n_elements_; ++i) {
+        swap(longer.data_[i], shorter.data_[i]);
+      }
+      size_t tail = longer.n_elements_ - shorter.n_elements_;
+      RelocateRange(longer.data_ + shorter.n_elements_, tail, shorter.data_ + shorter.n_elements_);
+      DestroyRange(longer.data_ + shorter.n_elements_, longer.data_ + longer.n_elements_);
+      std::swap(longer.n_elements_, shorter.n_elements_);
+    }
+  }
+
+  ~SmallVector() noexcept {
+    ReleaseStorage();
+  }
+};
+
+#endif
@@ -0,0 +1,369 @@
+#ifndef LARGETASKS_SOA_VECTOR_H
+#define LARGETASKS_SOA_VECTOR_H
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__has_include)
+#if __has_include(<span>)
+#include <span>
+#endif
+#endif
+
+// Structure-of-arrays counterpart of Vector<std::tuple<Fields...>>: field I of every row lives in its own
+// contiguous column aligned to kColumnAlignment, so a scan over one field only streams that column through the
+// cache and Data<I>() can be fed straight to SIMD kernels. Rows are accessed through tuples of references.
+// Growth follows Vector (amortized O(1), strong guarantee); fields must be nothrow-movable to be relocated.
+template <class... Fields>
+class SoaVector {
+  static_assert(sizeof...(Fields) > 0, "SoaVector needs at least one field");
+  static_assert((std::is_nothrow_move_constructible_v<Fields> && ...), "SoaVector fields must be nothrow-movable");
+
+ public:
+  using ValueType = std::tuple<Fields...>;
+  using Reference = std::tuple<Fields&...>;
+  using ConstReference = std::tuple<const Fields&...>;
+  using SizeType = size_t;
+
+  template <size_t I>
+  using FieldType = std::tuple_element_t<I, ValueType>;
+
+  static constexpr size_t kFieldsNumber = sizeof...(Fields);
+  static constexpr size_t kColumnAlignment = 64;
+
+ private:
+  using Columns = std::tuple<Fields*...>;
+  using FieldIndices = std::index_sequence_for<Fields...>;
+
+  static constexpr size_t kGrowthFactor = 2;
+
+  Columns columns_{};
+  size_t n_elements_ = 0;
+  size_t capacity_ = 0;
+
+  template <class Function, size_t... Is>
+  static void ForEachFieldIndex(const Function& function, std::index_sequence<Is...>) {
+    (function(std::integral_constant<size_t, Is>{}), ...);
+  }
+
+  // Calls function(std::integral_constant<size_t, I>) for every field index I.
+  template <class Function>
+  static void ForEachField(const Function& function) {
+    ForEachFieldIndex(function, FieldIndices{});
+  }
+
+  template <class F>
+  static constexpr std::align_val_t ColumnAlignment() noexcept {
+    return std::align_val_t{std::max(kColumnAlignment, alignof(F))};
+  }
+
+  static Columns AllocateColumns(size_t n) {
+    Columns columns{};
+    if (n == 0) {
+      return columns;
+    }
+    try {
+      ForEachField([&](auto field) {
+        using F = FieldType<field>;
+        std::get<field>(columns) = static_cast<F*>(::operator new(n * sizeof(F), ColumnAlignment<F>()));
+      });
+    } catch (...) {
+      DeallocateColumns(columns);
+      throw;
+    }
+    return columns;
+  }
+
+  static void DeallocateColumns(const Columns& columns) noexcept {
+    ForEachField([&](auto field) {
+      using F = FieldType<field>;
+      if (std::get<field>(columns) != nullptr) {
+        ::operator delete(std::get<field>(columns), ColumnAlignment<F>());
+      }
+    });
+  }
+
+  static void DestroyRows(const Columns& columns, size_t from, size_t to) noexcept {
+    ForEachField([&](auto field) {
+      using F = FieldType<field>;
+      if constexpr (!std::is_trivially_destructible_v<F>) {
+        std::destroy(std::get<field>(columns) + from, std::get<field>(columns) + to);
+      }
+    });
+  }
+
+  // Builds row `index` field by field; if a field constructor throws, the fields already built are destroyed.
+  template <size_t... Is, class... Args>
+  static void ConstructRow(const Columns& columns, size_t index, std::index_sequence<Is...>, Args&&... args) {
+    size_t built = 0;
+    try {
+      ((::new (static_cast<void*>(std::get<Is>(columns) + index)) Fields(std::forward<Args>(args)), ++built), ...);
+    } catch (...) {
+      ForEachField([&](auto field) {
+        using F = FieldType<field>;
+        if (field < built) {
+          std::get<field>(columns)[index].~F();
+        }
+      });
+      throw;
+    }
+  }
+
+  static void RelocateRows(const Columns& from, size_t n, const Columns& to) noexcept {
+    ForEachField([&](auto field) {
+      using F = FieldType<field>;
+      F* source = std::get<field>(from);
+      F* target = std::get<field>(to);
+      if constexpr (std::is_trivially_copyable_v<F>) {
+        if (n != 0) {
+          std::memcpy(static_cast<void*>(target), source, n * sizeof(F));
+        }
+      } else {
+        for (size_t i = 0u; i < n; ++i) {
+          ::new (static_cast<void*>(target + i)) F(std::move(source[i]));
+        }
+        std::destroy_n(source, n);
+      }
+    });
+  }
+
+  [[nodiscard]] size_t GrownCapacity(size_t required) const noexcept {
+    return std::max(required, capacity_ * kGrowthFactor);
+  }
+
+  // Moves every column into fresh storage after construct_new_row has built row n_elements_ there (if it is
+  // given), so the new row may still be built from references into this vector. Nothing changes on a throw.
+  template <class ConstructNewRow>
+  void Reallocate(size_t new_capacity, const ConstructNewRow& construct_new_row) {
+    Columns new_columns = AllocateColumns(new_capacity);
+    try {
+      construct_new_row(new_columns);
+    } catch (...) {
+      DeallocateColumns(new_columns);
+      throw;
+    }
+    RelocateRows(columns_, n_elements_, new_columns);
+    DeallocateColumns(columns_);
+    columns_ = new_columns;
+    capacity_ = new_capacity;
+  }
+
+  template <size_t... Is>
+  Reference MakeReference(size_t n, std::index_sequence<Is...>) noexcept {
+    return Reference(std::get<Is>(columns_)[n]...);
+  }
+
+  template <size_t... Is>
+  ConstReference MakeReference(size_t n, std::index_sequence<Is...>) const noexcept {
+    return ConstReference(std::get<Is>(columns_)[n]...);
+  }
+
+  void Release() noexcept {
+    DestroyRows(columns_, 0u, n_elements_);
+    DeallocateColumns(columns_);
+    columns_ = Columns{};
+    n_elements_ = 0;
+    capacity_ = 0;
+  }
+
+ public:
+  SoaVector() noexcept = default;
+
+  explicit SoaVector(size_t n) {
+    Resize(n);
+  }
+
+  SoaVector(const SoaVector<Fields...>& other) {
+    Reserve(other.n_elements_);
+    try {
+      for (size_t i = 0u; i < other.n_elements_; ++i) {
+        std::apply([this](const auto&... values) { EmplaceBack(values...); }, other[i]);
+      }
+    } catch (...) {
+      Release();
+      throw;
+    }
+  }
+
+  SoaVector<Fields...>& operator=(const SoaVector<Fields...>& other) {
+    if (this != &other) {
+      SoaVector<Fields...> copy(other);
+      Swap(copy);
+    }
+    return *this;
+  }
+
+  SoaVector(SoaVector<Fields...>&& rvalue_vector) noexcept {
+    Swap(rvalue_vector);
+  }
+
+  SoaVector<Fields...>& operator=(SoaVector<Fields...>&& rvalue_vector) noexcept {
+    if (this != &rvalue_vector) {
+      Release();
+      Swap(rvalue_vector);
+    }
+    return *this;
+  }
+
+  [[nodiscard]] size_t Size() const noexcept {
+    return n_elements_;
+  }
+
+  [[nodiscard]] size_t Capacity() const noexcept {
+    return capacity_;
+  }
+
+  [[nodiscard]] bool Empty() const noexcept {
+    return (n_elements_ == 0);
+  }
+
+  Reference operator[](size_t n) noexcept {
+    return MakeReference(n, FieldIndices{});
+  }
+
+  ConstReference operator[](size_t n) const noexcept {
+    return MakeReference(n, FieldIndices{});
+  }
+
+  Reference At(size_t n) {
+    if (n >= n_elements_) {
+      throw std::out_of_range("");
+    }
+    return (*this)[n];
+  }
+
+  ConstReference At(size_t n) const {
+    if (n >= n_elements_) {
+      throw std::out_of_range("");
+    }
+    return (*this)[n];
+  }
+
+  Reference Front() noexcept {
+    return (*this)[0];
+  }
+
+  ConstReference Front() const noexcept {
+    return (*this)[0];
+  }
+
+  Reference Back() noexcept {
+    return (*this)[n_elements_ - 1];
+  }
+
+  ConstReference Back() const noexcept {
+    return (*this)[n_elements_ - 1];
+  }
+
+  template <size_t I>
+  FieldType<I>& Get(size_t n) noexcept {
+    return std::get<I>(columns_)[n];
+  }
+
+  template <size_t I>
+  const FieldType<I>& Get(size_t n) const noexcept {
+    return std::get<I>(columns_)[n];
+  }
+
+  // Column I as a contiguous array of Size() elements aligned to kColumnAlignment.
+  template <size_t I>
+  FieldType<I>* Data() noexcept {
+    return (n_elements_ == 0 ? nullptr : std::get<I>(columns_));
+  }
+
+  template <size_t I>
+  const FieldType<I>* Data() const noexcept {
+    return (n_elements_ == 0 ? nullptr : std::get<I>(columns_));
+  }
+
+#if defined(__cpp_lib_span)
+  template <size_t I>
+  std::span<FieldType<I>> Column() noexcept {
+    return {std::get<I>(columns_), n_elements_};
+  }
+
+  template <size_t I>
+  std::span<const FieldType<I>> Column() const noexcept {
+    return {std::get<I>(columns_), n_elements_};
+  }
+#endif
+
+  // Takes exactly one constructor argument per field.
+  template <class... Args>
+  Reference EmplaceBack(Args&&... args) {
+    static_assert(sizeof...(Args) == sizeof...(Fields), "EmplaceBack takes one argument per field");
+    if (n_elements_ == capacity_) {
+      Reallocate(GrownCapacity(n_elements_ + 1), [&](const Columns& new_columns) {
+        ConstructRow(new_columns, n_elements_, FieldIndices{}, std::forward<Args>(args)...);
+      });
+    } else {
+      ConstructRow(columns_, n_elements_, FieldIndices{}, std::forward<Args>(args)...);
+    }
+    return (*this)[n_elements_++];
+  }
+
+  void PushBack(const ValueType& row) {
+    std::apply([this](const auto&... values) { EmplaceBack(values...); }, row);
+  }
+
+  void PushBack(ValueType&& row) {
+    std::apply([this](auto&... values) { EmplaceBack(std::move(values)...); }, row);
+  }
+
+  void PopBack() noexcept {
+    if (n_elements_ != 0) {
+      --n_elements_;
+      DestroyRows(columns_, n_elements_, n_elements_ + 1);
+    }
+  }
+
+  void Reserve(size_t n) {
+    if (n > capacity_) {
+      Reallocate(n, [](const Columns&) {});
+    }
+  }
+
+  void Resize(size_t n) {
+    if (n <= n_elements_) {
+      DestroyRows(columns_, n, n_elements_);
+      n_elements_ = n;
+      return;
+    }
+    if (n > capacity_) {
+      Reserve(GrownCapacity(n));
+    }
+    while (n_elements_ < n) {
+      EmplaceBack(Fields()...);
+    }
+  }
+
+  void Clear() noexcept {
+    DestroyRows(columns_, 0u, n_elements_);
+    n_elements_ = 0;
+  }
+
+  void ShrinkToFit() {
+    if (capacity_ > n_elements_) {
+      Reallocate(n_elements_, [](const Columns&) {});
+    }
+  }
+
+  void Swap(SoaVector<Fields...>& other) noexcept {
+    std::swap(columns_, other.columns_);
+    std::swap(n_elements_, other.n_elements_);
+    std::swap(capacity_, other.capacity_);
+  }
+
+  ~SoaVector() noexcept {
+    Release();
+  }
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define LARGETASKS_VECTOR_H
 
 #include <cstdint>
+#include <cstring>
 #include <algorithm>
 #include <iterator>
 #include <utility>
@@ -10,7 +11,27 @@
 #include <stdexcept>
 #include <type_traits>
 
-template <class T>
+#include "vector_storage.h"
+
+// Optional allocator hooks (see H_Allocators/huge_page_allocator.h): Remap resizes an allocation in place and
+// IsZeroFilled reports that fresh storage is already zeroed.
+template <class Allocator, class = void>
+struct AllocatorCanRemap : std::false_type {};
+
+template <class Allocator>
+struct AllocatorCanRemap<Allocator, std::void_t<decltype(std::declval<Allocator&>().Remap(
+                                        std::declval<typename Allocator::value_type*>(), size_t{}, size_t{}))>>
+    : std::true_type {};
+
+template <class Allocator, class = void>
+struct AllocatorReportsZeroFill : std::false_type {};
+
+template <class Allocator>
+struct AllocatorReportsZeroFill<Allocator,
+                                std::void_t<decltype(std::declval<const Allocator&>().IsZeroFilled(size_t{}))>>
+    : std::true_type {};
+
+template <class T, class Allocator = std::allocator<T>>
 class Vector {
  public:
   using ValueType = T;
@@ -19,138 +40,234 @@ class Vector {
   using Reference = T&;
   using ConstReference = const T&;
   using SizeType = size_t;
-  //  using Iterator = decltype(std::begin(std::declval<T&>()));
-  //  using ConstIterator = decltype(std::begin(std::declval<const T&>()));
+  using AllocatorType = Allocator;
+  using Iterator = T*;
+  using ConstIterator = const T*;
+  using ReverseIterator = std::reverse_iterator<Iterator>;
+  using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
 
  private:
-  T* inner_array_;
+  using AllocatorTraits = std::allocator_traits<Allocator>;
+  using Storage = VectorStorage<T, Allocator>;
+
+  static constexpr size_t kGrowthFactor = 2;
+  static constexpr bool kCanRemap = std::is_trivially_copyable_v<T> && AllocatorCanRemap<Allocator>::value;
+
+  Allocator allocator_;
+  T* inner_array_ = nullptr;
   size_t n_elements_ = 0;
   size_t capacity_ = 0;
 
+  T* AllocateStorage(size_t n) {
+    return (n == 0 ? nullptr : AllocatorTraits::allocate(allocator_, n));
+  }
+
+  void DeallocateStorage(T* data, size_t n) noexcept {
+    if (data != nullptr) {
+      AllocatorTraits::deallocate(allocator_, data, n);
+    }
+  }
+
+  void DestroyRange(T* first, T* last) noexcept {
+    Storage::DestroyRange(allocator_, first, last);
+  }
+
   void DeallocateVectorMemory() noexcept {
-    //    std::destroy(begin(inner_array_), end(inner_array_));
-    //    for (size_t i = 0u; i < n_elements_; ++i) {
-    //      DeallocateTopValue();
-    //    }
+    DestroyRange(inner_array_, inner_array_ + n_elements_);
+    DeallocateStorage(inner_array_, capacity_);
+    inner_array_ = nullptr;
     n_elements_ = 0;
     capacity_ = 0;
-    delete[] inner_array_;
   }
 
-  void DeallocateTopValue() noexcept {
-    try {
-      if (n_elements_ != 0) {
-        std::destroy_at((inner_array_ + n_elements_));
-        n_elements_--;
-      }
-    } catch (...) {
-    }
+  void ValueConstruct(T* first, size_t n) {
+    Storage::ValueConstruct(allocator_, first, n);
   }
 
-  void AllocateNewValue(T& value_to_place) noexcept {
-    T* placement_mem = nullptr;
-    try {
-      if (!std::is_copy_constructible<T>().value) {
-        placement_mem = new ((inner_array_ + n_elements_)) T(std::forward<T>(value_to_place));
-      } else {
-        placement_mem = new ((inner_array_ + n_elements_)) T(value_to_place);
+  // Value-initializes freshly allocated storage, skipping the pass when the allocator hands out zeroed pages.
+  void ValueConstructFresh(T* first, size_t n) {
+    if constexpr (std::is_trivial_v<T> && AllocatorReportsZeroFill<Allocator>::value) {
+      if (allocator_.IsZeroFilled(n)) {
+        return;
       }
-      n_elements_++;
-    } catch (...) {
-      DeallocateTopValue();
-      delete placement_mem;
     }
+    ValueConstruct(first, n);
   }
 
- public:
-  Vector() noexcept {
+  void FillConstruct(T* first, size_t n, const T& value) {
+    Storage::FillConstruct(allocator_, first, n, value);
+  }
+
+  [[nodiscard]] size_t GrownCapacity(size_t required) const noexcept {
+    return std::max(required, capacity_ * kGrowthFactor);
+  }
+
+  // Moves the live elements into a fresh buffer of new_capacity slots after construct_new_slots has built the
+  // elements that follow them. construct_new_slots runs first, so it may read from the old elements, and must
+  // build exactly n_new elements or clean up after itself; *this is left untouched if any step throws.
+  // If the allocator can remap, trivially copyable elements stay where the kernel moves them and
+  // construct_new_slots runs afterwards, so with kCanRemap callers must not pass references into the vector.
+  template <class ConstructNewSlots>
+  void Reallocate(size_t new_capacity, size_t n_new, const ConstructNewSlots& construct_new_slots) {
+    if constexpr (kCanRemap) {
+      if (inner_array_ != nullptr && new_capacity != 0) {
+        if (T* remapped = allocator_.Remap(inner_array_, capacity_, new_capacity)) {
+          inner_array_ = remapped;
+          capacity_ = new_capacity;
+          construct_new_slots(inner_array_ + n_elements_);
+          return;
+        }
+      }
+    }
+    T* new_array = AllocateStorage(new_capacity);
     try {
-      inner_array_ = new T[0];
-      n_elements_ = 0;
-      capacity_ = 0;
+      Storage::RelocateWithNewSlots(allocator_, inner_array_, n_elements_, new_array, n_new, construct_new_slots);
     } catch (...) {
-      DeallocateVectorMemory();
+      DeallocateStorage(new_array, new_capacity);
       throw;
     }
+    DestroyRange(inner_array_, inner_array_ + n_elements_);
+    DeallocateStorage(inner_array_, capacity_);
+    inner_array_ = new_array;
+    capacity_ = new_capacity;
+  }
+
+  // Builds n elements in raw storage at `target` from the ones starting at `first`.
+  template <class ForwardIt>
+  void ConstructCopies(T* target, ForwardIt first, size_t n) {
+    if constexpr (std::is_pointer_v<ForwardIt> && std::is_trivially_copyable_v<T> &&
+                  std::is_same_v<std::remove_cv_t<std::remove_pointer_t<ForwardIt>>, T>) {
+      if (n != 0) {
+        std::memcpy(static_cast<void*>(target), first, n * sizeof(T));
+      }
+    } else {
+      Storage::ConstructRange(allocator_, target, n, [this, &first](T* slot, size_t) {
+        AllocatorTraits::construct(allocator_, slot, *first);
+        ++first;
+      });
+    }
+  }
+
+  // Replaces the elements with the n starting at `first`, built in storage from this vector's own allocator: in
+  // place when they fit, otherwise through Reallocate, so a remapping allocator grows its buffer rather than
+  // allocating a second one. The vector is left empty if an element throws.
+  template <class ForwardIt>
+  void AssignElements(ForwardIt first, size_t n) {
+    Clear();
+    if (n > capacity_) {
+      Reallocate(n, n, [this, first, n](T* slot) { ConstructCopies(slot, first, n); });
+    } else {
+      ConstructCopies(inner_array_, first, n);
+    }
+    n_elements_ = n;
   }
 
-  explicit Vector(size_t n) noexcept {
+  void SwapBuffers(Vector<T, Allocator>& other) noexcept {
+    std::swap(inner_array_, other.inner_array_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(n_elements_, other.n_elements_);
+  }
+
+  template <class ConstructTail>
+  void ResizeWith(size_t n, const ConstructTail& construct_tail) {
+    Storage::Resize(allocator_, inner_array_, n_elements_, capacity_, n,
+                    [&](size_t n_new, const auto& construct_new_slots) {
+                      Reallocate(GrownCapacity(n), n_new, construct_new_slots);
+                    },
+                    construct_tail);
+    n_elements_ = n;
+  }
+
+ public:
+  Vector() noexcept = default;
+
+  explicit Vector(const Allocator& allocator) noexcept : allocator_(allocator) {
+  }
+
+  explicit Vector(size_t n, const Allocator& allocator = Allocator())
+      : allocator_(allocator), inner_array_(AllocateStorage(n)), capacity_(n) {
     try {
-      inner_array_ = new T[n];
-      capacity_ = n;
-      n_elements_ = n;
+      ValueConstructFresh(inner_array_, n);
     } catch (...) {
       DeallocateVectorMemory();
       throw;
     }
+    n_elements_ = n;
   }
 
-  Vector(size_t n, T value) noexcept {
+  Vector(size_t n, const T& value, const Allocator& allocator = Allocator())
+      : allocator_(allocator), inner_array_(AllocateStorage(n)), capacity_(n) {
     try {
-      inner_array_ = new T[n];
-      for (size_t i = 0u; i < n; ++i) {
-        AllocateNewValue(value);
-      }
-      capacity_ = n;
+      FillConstruct(inner_array_, n, value);
     } catch (...) {
       DeallocateVectorMemory();
       throw;
     }
+    n_elements_ = n;
   }
 
-  template <class Iterator, class = std::enable_if_t<std::is_base_of_v<
-                                std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>>>
-  Vector(Iterator begin, Iterator end) noexcept {
+  template <class ForwardIt,
+            class = std::enable_if_t<std::is_base_of_v<std::forward_iterator_tag,
+                                                       typename std::iterator_traits<ForwardIt>::iterator_category>>>
+  Vector(ForwardIt begin, ForwardIt end, const Allocator& allocator = Allocator()) : allocator_(allocator) {
+    size_t n = static_cast<size_t>(std::distance(begin, end));
+    inner_array_ = AllocateStorage(n);
+    capacity_ = n;
     try {
-      size_t n = std::distance(begin, end);
-      inner_array_ = new T[n];
-      capacity_ = n;
-      for (Iterator it = begin; it != end; ++it) {
-        T value = *it;
-        AllocateNewValue(value);
-      }
+      ConstructCopies(inner_array_, begin, n);
     } catch (...) {
       DeallocateVectorMemory();
       throw;
     }
+    n_elements_ = n;
   }
 
-  Vector(std::initializer_list<T> init_list) noexcept {
-    Vector(init_list.begin(), init_list.end());
+  Vector(std::initializer_list<T> init_list, const Allocator& allocator = Allocator())
+      : Vector(init_list.begin(), init_list.end(), allocator) {
   }
 
-  Vector(const Vector<T>& other_vector) noexcept {
-    this->inner_array_ = other_vector.inner_array_;
-    this->capacity_ = other_vector.capacity_;
-    this->n_elements_ = other_vector.n_elements_;
+  Vector(const Vector<T, Allocator>& other_vector)
+      : Vector(other_vector.begin(), other_vector.end(),
+               AllocatorTraits::select_on_container_copy_construction(other_vector.allocator_)) {
   }
 
-  Vector<T>& operator=(const Vector<T>& other_vector) noexcept {
+  // Keeps this vector's allocator unless it propagates on copy assignment, as std::vector does, so an arena- or
+  // file-backed vector stays on its own storage.
+  Vector<T, Allocator>& operator=(const Vector<T, Allocator>& other_vector) {
     if (this != &other_vector) {
-      DeallocateVectorMemory();
-      this->inner_array_ = other_vector.inner_array_;
-      this->capacity_ = other_vector.capacity_;
-      this->n_elements_ = other_vector.n_elements_;
+      if constexpr (AllocatorTraits::propagate_on_container_copy_assignment::value) {
+        if (allocator_ != other_vector.allocator_) {
+          Vector<T, Allocator> copy(other_vector.begin(), other_vector.end(), other_vector.allocator_);
+          SwapBuffers(copy);
+          std::swap(allocator_, copy.allocator_);
+          return *this;
+        }
+        allocator_ = other_vector.allocator_;
+      }
+      AssignElements(other_vector.inner_array_, other_vector.n_elements_);
     }
     return *this;
   }
 
-  Vector(Vector<T>&& rvalue_vector) noexcept {
-    this->inner_array_ = std::move(rvalue_vector.inner_array_);
-    this->n_elements_ = rvalue_vector.n_elements_;
-    this->capacity_ = rvalue_vector.capacity_;
-    rvalue_vector.capacity_ = 0;
-    rvalue_vector.n_elements_ = 0;
+  Vector(Vector<T, Allocator>&& rvalue_vector) noexcept : allocator_(rvalue_vector.allocator_) {
+    SwapBuffers(rvalue_vector);
   }
 
-  Vector<T>& operator=(Vector<T>&& rvalue_vector) noexcept {
+  // Steals the buffer when the allocator propagates or both allocators are equal; otherwise moves the elements
+  // one by one into storage from this vector's allocator.
+  Vector<T, Allocator>& operator=(Vector<T, Allocator>&& rvalue_vector) noexcept(
+      AllocatorTraits::propagate_on_container_move_assignment::value || AllocatorTraits::is_always_equal::value) {
     if (this != &rvalue_vector) {
-      DeallocateVectorMemory();
-      this->inner_array_ = std::move(rvalue_vector.inner_array_);
-      this->n_elements_ = rvalue_vector.n_elements_;
-      this->capacity_ = rvalue_vector.capacity_;
-      rvalue_vector.capacity_ = 0;
-      rvalue_vector.n_elements_ = 0;
+      if (AllocatorTraits::propagate_on_container_move_assignment::value || allocator_ == rvalue_vector.allocator_) {
+        DeallocateVectorMemory();
+        if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value) {
+          allocator_ = rvalue_vector.allocator_;
+        }
+        SwapBuffers(rvalue_vector);
+      } else {
+        AssignElements(std::make_move_iterator(rvalue_vector.inner_array_), rvalue_vector.n_elements_);
+        rvalue_vector.Clear();
+      }
     }
     return *this;
   }
@@ -213,10 +330,129 @@ class Vector {
     return (n_elements_ == 0 ? nullptr : inner_array_);
   }
 
-  void Swap(Vector<T>& other) {
-    std::swap(inner_array_, other.inner_array_);
-    std::swap(capacity_, other.capacity_);
-    std::swap(n_elements_, other.n_elements_);
+  // Plain pointers: contiguous iterators usable with STL algorithms, execution policies and ranges.
+  Iterator begin() noexcept {  // NOLINT
+    return inner_array_;
+  }
+
+  ConstIterator begin() const noexcept {  // NOLINT
+    return inner_array_;
+  }
+
+  ConstIterator cbegin() const noexcept {  // NOLINT
+    return inner_array_;
+  }
+
+  Iterator end() noexcept {  // NOLINT
+    return inner_array_ + n_elements_;
+  }
+
+  ConstIterator end() const noexcept {  // NOLINT
+    return inner_array_ + n_elements_;
+  }
+
+  ConstIterator cend() const noexcept {  // NOLINT
+    return inner_array_ + n_elements_;
+  }
+
+  ReverseIterator rbegin() noexcept {  // NOLINT
+    return ReverseIterator(end());
+  }
+
+  ConstReverseIterator rbegin() const noexcept {  // NOLINT
+    return ConstReverseIterator(end());
+  }
+
+  ConstReverseIterator crbegin() const noexcept {  // NOLINT
+    return ConstReverseIterator(end());
+  }
+
+  ReverseIterator rend() noexcept {  // NOLINT
+    return ReverseIterator(begin());
+  }
+
+  ConstReverseIterator rend() const noexcept {  // NOLINT
+    return ConstReverseIterator(begin());
+  }
+
+  ConstReverseIterator crend() const noexcept {  // NOLINT
+    return ConstReverseIterator(begin());
+  }
+
+  // Amortized O(1): the capacity at least doubles whenever the buffer is full.
+  template <class... Args>
+  T& EmplaceBack(Args&&... args) {
+    if (n_elements_ == capacity_) {
+      if constexpr (kCanRemap) {
+        const T value(std::forward<Args>(args)...);
+        Reallocate(GrownCapacity(n_elements_ + 1), 1u,
+                   [&](T* slot) { AllocatorTraits::construct(allocator_, slot, value); });
+      } else {
+        Reallocate(GrownCapacity(n_elements_ + 1), 1u, [&](T* slot) {
+          AllocatorTraits::construct(allocator_, slot, std::forward<Args>(args)...);
+        });
+      }
+    } else {
+      AllocatorTraits::construct(allocator_, inner_array_ + n_elements_, std::forward<Args>(args)...);
+    }
+    return inner_array_[n_elements_++];
+  }
+
+  void PushBack(const T& value) {
+    EmplaceBack(value);
+  }
+
+  void PushBack(T&& value) {
+    EmplaceBack(std::move(value));
+  }
+
+  void PopBack() noexcept {
+    if (n_elements_ != 0) {
+      --n_elements_;
+      DestroyRange(inner_array_ + n_elements_, inner_array_ + n_elements_ + 1);
+    }
+  }
+
+  void Reserve(size_t n) {
+    if (n > capacity_) {
+      Reallocate(n, 0u, [](T*) {});
+    }
+  }
+
+  void Resize(size_t n) {
+    ResizeWith(n, [this](T* first, size_t count) { ValueConstruct(first, count); });
+  }
+
+  void Resize(size_t n, const T& value) {
+    if constexpr (kCanRemap) {
+      const T copy = value;
+      ResizeWith(n, [this, &copy](T* first, size_t count) { FillConstruct(first, count, copy); });
+    } else {
+      ResizeWith(n, [this, &value](T* first, size_t count) { FillConstruct(first, count, value); });
+    }
+  }
+
+  void Clear() noexcept {
+    DestroyRange(inner_array_, inner_array_ + n_elements_);
+    n_elements_ = 0;
+  }
+
+  void ShrinkToFit() {
+    if (capacity_ > n_elements_) {
+      Reallocate(n_elements_, 0u, [](T*) {});
+    }
+  }
+
+  [[nodiscard]] Allocator GetAllocator() const noexcept {
+    return allocator_;
+  }
+
+  // The allocators are exchanged only if they propagate on swap; otherwise they must compare equal.
+  void Swap(Vector<T, Allocator>& other) noexcept {
+    if constexpr (AllocatorTraits::propagate_on_container_swap::value) {
+      std::swap(allocator_, other.allocator_);
+    }
+    SwapBuffers(other);
   }
 
   ~Vector() noexcept {
@@ -0,0 +1,103 @@
+#ifndef LARGETASKS_VECTOR_STORAGE_H
+#define LARGETASKS_VECTOR_STORAGE_H
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Raw-storage steps shared by Vector and SmallVector. Elements are built and destroyed through allocator, and
+// every step that builds elements destroys the ones it built before an exception leaves it.
+template <class T, class Allocator>
+struct VectorStorage {
+  using AllocatorTraits = std::allocator_traits<Allocator>;
+
+  static void DestroyRange(Allocator& allocator, T* first, T* last) noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (; first != last; ++first) {
+        AllocatorTraits::destroy(allocator, first);
+      }
+    }
+  }
+
+  // Builds n elements in raw storage at `first` with construct(slot, index).
+  template <class Construct>
+  static void ConstructRange(Allocator& allocator, T* first, size_t n, const Construct& construct) {
+    size_t built = 0;
+    try {
+      for (; built < n; ++built) {
+        construct(first + built, built);
+      }
+    } catch (...) {
+      DestroyRange(allocator, first, first + built);
+      throw;
+    }
+  }
+
+  static void ValueConstruct(Allocator& allocator, T* first, size_t n) {
+    if constexpr (std::is_trivial_v<T>) {
+      if (n != 0) {
+        std::memset(static_cast<void*>(first), 0, n * sizeof(T));
+      }
+    } else {
+      ConstructRange(allocator, first, n,
+                     [&allocator](T* slot, size_t) { AllocatorTraits::construct(allocator, slot); });
+    }
+  }
+
+  static void FillConstruct(Allocator& allocator, T* first, size_t n, const T& value) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      std::uninitialized_fill_n(first, n, value);
+    } else {
+      ConstructRange(allocator, first, n,
+                     [&allocator, &value](T* slot, size_t) { AllocatorTraits::construct(allocator, slot, value); });
+    }
+  }
+
+  // Builds the n elements at `source` in raw storage at `target`: memcpy for trivially copyable T, otherwise a
+  // move when it cannot throw (or T is move-only) and a copy when it can, so `source` stays intact on a throw.
+  static void RelocateRange(Allocator& allocator, T* source, size_t n, T* target) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      if (n != 0) {
+        std::memcpy(static_cast<void*>(target), source, n * sizeof(T));
+      }
+    } else {
+      ConstructRange(allocator, target, n, [&allocator, source](T* slot, size_t i) {
+        AllocatorTraits::construct(allocator, slot, std::move_if_noexcept(source[i]));
+      });
+    }
+  }
+
+  // The element-moving half of a reallocation: construct_new_slots builds the n_new elements that follow the n
+  // live ones in `target` first, so it may still read from `source`, then the live elements are relocated in
+  // front of them. If either step throws, `target` holds no live element; freeing it is up to the caller.
+  template <class ConstructNewSlots>
+  static void RelocateWithNewSlots(Allocator& allocator, T* source, size_t n, T* target, size_t n_new,
+                                   const ConstructNewSlots& construct_new_slots) {
+    construct_new_slots(target + n);
+    try {
+      RelocateRange(allocator, source, n, target);
+    } catch (...) {
+      DestroyRange(allocator, target + n, target + n + n_new);
+      throw;
+    }
+  }
+
+  // Changes the number of live elements at `data` from n_elements to n. Past capacity,
+  // grow(n_new, construct_new_slots) must reallocate as RelocateWithNewSlots does; otherwise the tail is built
+  // in place with construct_tail(first, count) or destroyed. The caller records the new size.
+  template <class Grow, class ConstructTail>
+  static void Resize(Allocator& allocator, T* data, size_t n_elements, size_t capacity, size_t n, const Grow& grow,
+                     const ConstructTail& construct_tail) {
+    if (n > capacity) {
+      grow(n - n_elements, [&](T* first) { construct_tail(first, n - n_elements); });
+    } else if (n > n_elements) {
+      construct_tail(data + n_elements, n - n_elements);
+    } else {
+      DestroyRange(allocator, data + n, data + n_elements);
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,88 @@
+// Reference-count cost of SharedPtr under both counter policies: single-threaded copies, and copies of one shared
+// pointer from several threads, where NonAtomicCounterPolicy needs the mutex the atomic counters replace; plus
+// WeakPtr::Lock under contention.
+// Build and run from the repository root (the argument is copies per thread, 2M by default):
+//   g++ -std=c++17 -O2 -pthread -I. E_SharedPtr/bench_shared_ptr.cpp -o bench_shared_ptr && ./bench_shared_ptr
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "E_SharedPtr/shared_ptr.h"
+
+namespace {
+
+constexpr size_t kSlots = 8;
+
+// Runs body(copies) on `threads` threads at once; returns nanoseconds per copy.
+template <class Body>
+double NanosecondsPerCopy(size_t threads, size_t copies, const Body& body) {
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (size_t t = 0u; t < threads; ++t) {
+    workers.emplace_back([&body, copies] { body(copies); });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  return elapsed / static_cast<double>(threads * copies);
+}
+
+// Copy-assigns source into a ring of kSlots pointers, so every copy takes one reference and drops another.
+template <class Pointer, class Guard>
+void CopyInto(const Pointer& source, size_t copies, Guard& guard) {
+  Pointer slots[kSlots];
+  for (size_t i = 0u; i < copies; ++i) {
+    std::lock_guard<Guard> lock(guard);
+    slots[i % kSlots] = source;
+  }
+  std::lock_guard<Guard> lock(guard);
+  for (auto& slot : slots) {
+    slot = Pointer();
+  }
+}
+
+// Stands in for a mutex where the counters need none.
+struct NoLock {
+  void lock() noexcept {  // NOLINT
+  }
+  void unlock() noexcept {  // NOLINT
+  }
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  size_t copies = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000u);
+  auto atomic = AllocateShared<int, AtomicCounterPolicy>(std::allocator<int>(), 42);
+  auto non_atomic = AllocateShared<int, NonAtomicCounterPolicy>(std::allocator<int>(), 42);
+  WeakPtr<int, AtomicCounterPolicy> weak(atomic);
+  NoLock no_lock;
+  std::mutex mutex;
+
+  std::printf("ns per copy, %zu copies per thread (%u hardware threads)\n", copies,
+              std::thread::hardware_concurrency());
+  std::printf("%8s %16s %16s %22s %16s\n", "threads", "non-atomic", "atomic", "non-atomic + mutex", "WeakPtr::Lock");
+  for (size_t threads : {1u, 2u, 4u, 8u}) {
+    double plain = (threads == 1 ? NanosecondsPerCopy(1, copies, [&](size_t n) { CopyInto(non_atomic, n, no_lock); })
+                                 : 0.0);
+    double lock_free = NanosecondsPerCopy(threads, copies, [&](size_t n) { CopyInto(atomic, n, no_lock); });
+    double locked = NanosecondsPerCopy(threads, copies, [&](size_t n) { CopyInto(non_atomic, n, mutex); });
+    double weak_lock = NanosecondsPerCopy(threads, copies, [&](size_t n) {
+      SharedPtr<int, AtomicCounterPolicy> slots[kSlots];
+      for (size_t i = 0u; i < n; ++i) {
+        slots[i % kSlots] = weak.Lock();
+      }
+    });
+    if (threads == 1) {
+      std::printf("%8zu %16.2f %16.2f %22.2f %16.2f\n", threads, plain, lock_free, locked, weak_lock);
+    } else {
+      std::printf("%8zu %16s %16.2f %22.2f %16.2f\n", threads, "(unsafe)", lock_free, locked, weak_lock);
+    }
+  }
+  return (*atomic + *non_atomic == 84 ? 0 : 1);
+}
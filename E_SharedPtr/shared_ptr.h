@@ -3,39 +3,247 @@
 #define LARGETASKS_SHARED_PTR_H
 #include <cstdint>
 #include <algorithm>
+#include <atomic>
 #include <exception>
+#include <memory>
+#include <new>
+#include <utility>
 
 class BadWeakPtr : std::exception {};
 
-template <class T>
+// Reference counts shared between threads. Increments only need atomicity: an owner can only be copied from an
+// existing owner, which already keeps the count above zero. Decrements are acq_rel so that every owner's use of the
+// object happens before the owner that drops the count to zero destroys it.
+struct AtomicCounterPolicy {
+  using CountType = std::atomic<int32_t>;
+
+  static void Increment(CountType& count) noexcept {
+    count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Returns the count left after the decrement.
+  static int32_t Decrement(CountType& count) noexcept {
+    return count.fetch_sub(1, std::memory_order_acq_rel) - 1;
+  }
+
+  // Takes a reference only while the count has not dropped to zero, since a zero count never comes back.
+  static bool IncrementIfNotZero(CountType& count) noexcept {
+    int32_t current = count.load(std::memory_order_relaxed);
+    while (current != 0) {
+      if (count.compare_exchange_weak(current, current + 1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static int32_t Load(const CountType& count) noexcept {
+    return count.load(std::memory_order_relaxed);
+  }
+};
+
+// Plain counts for pointers that never cross threads.
+struct NonAtomicCounterPolicy {
+  using CountType = int32_t;
+
+  static void Increment(CountType& count) noexcept {
+    ++count;
+  }
+
+  static int32_t Decrement(CountType& count) noexcept {
+    return --count;
+  }
+
+  static bool IncrementIfNotZero(CountType& count) noexcept {
+    if (count == 0) {
+      return false;
+    }
+    ++count;
+    return true;
+  }
+
+  static int32_t Load(const CountType& count) noexcept {
+    return count;
+  }
+};
+
+// Control block shared by the owners of one object. The weak count includes one reference held by the strong
+// owners as a group: it is released right after the object is destroyed, so whichever of the last strong owner
+// and the last weak owner finishes second frees the block, and neither has to read the other count to decide.
+// How the object is destroyed and how the block is freed depend on how the object was allocated, so the concrete
+// blocks below pass both operations in as function pointers.
+template <class Policy>
+struct BasicCounter {
+  using ReleaseFunction = void (*)(BasicCounter<Policy>*) noexcept;
+
+  typename Policy::CountType strong_counter_{1};
+  typename Policy::CountType weak_counter_{1};
+  ReleaseFunction destroy_object_;
+  ReleaseFunction deallocate_;
+
+  BasicCounter(ReleaseFunction destroy_object, ReleaseFunction deallocate) noexcept
+      : destroy_object_(destroy_object), deallocate_(deallocate) {
+  }
+
+  void AddStrongCounter() noexcept {
+    Policy::Increment(strong_counter_);
+  }
+
+  [[nodiscard]] bool AddStrongCounterIfAlive() noexcept {
+    return Policy::IncrementIfNotZero(strong_counter_);
+  }
+
+  // Returns true when the last strong owner has left.
+  [[nodiscard]] bool RemoveStrongCounter() noexcept {
+    return Policy::Decrement(strong_counter_) == 0;
+  }
+
+  void AddWeakCounter() noexcept {
+    Policy::Increment(weak_counter_);
+  }
+
+  // Returns true when the counter itself is no longer referenced.
+  [[nodiscard]] bool RemoveWeakCounter() noexcept {
+    return Policy::Decrement(weak_counter_) == 0;
+  }
+
+  [[nodiscard]] int32_t StrongCount() const noexcept {
+    return Policy::Load(strong_counter_);
+  }
+
+  // Drops a strong reference; the last one destroys the object and then gives up the strong owners' weak reference.
+  void ReleaseStrong() noexcept {
+    if (RemoveStrongCounter()) {
+      destroy_object_(this);
+      ReleaseWeak();
+    }
+  }
+
+  void ReleaseWeak() noexcept {
+    if (RemoveWeakCounter()) {
+      deallocate_(this);
+    }
+  }
+};
+
+using Counter = BasicCounter<AtomicCounterPolicy>;
+
+template <class T, class Policy = AtomicCounterPolicy>
 class WeakPtr;
 
-struct Counter {
-  int32_t strong_counter_;
-  int32_t weak_counter_;
+template <class T, class Policy = AtomicCounterPolicy>
+class SharedPtr;
+
+// Block for SharedPtr(T*): the object was allocated separately with new.
+template <class T, class Policy>
+class PointerControlBlock : public BasicCounter<Policy> {
+ private:
+  T* pointer_;
 
-  void AddStrongCounter() {
-    strong_counter_++;
+  static void DestroyObject(BasicCounter<Policy>* counter) noexcept {
+    delete static_cast<PointerControlBlock<T, Policy>*>(counter)->pointer_;
+  }
+
+  static void Deallocate(BasicCounter<Policy>* counter) noexcept {
+    delete static_cast<PointerControlBlock<T, Policy>*>(counter);
+  }
+
+ public:
+  explicit PointerControlBlock(T* pointer) noexcept
+      : BasicCounter<Policy>(&DestroyObject, &Deallocate), pointer_(pointer) {
   }
-  void RemoveStrongCounter() {
-    strong_counter_--;
+};
+
+// Block for AllocateShared and MakeShared: the object lives next to the counts in the same allocation, so a
+// shared object costs one allocation and its counts usually share a cache line with it. The object is destroyed
+// with the last strong reference; the storage goes back to the allocator with the last weak one.
+template <class T, class Policy, class Allocator>
+class InplaceControlBlock : public BasicCounter<Policy> {
+ private:
+  using ObjectAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+  using ObjectTraits = std::allocator_traits<ObjectAllocator>;
+  using BlockAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<InplaceControlBlock>;
+  using BlockTraits = std::allocator_traits<BlockAllocator>;
+
+  ObjectAllocator allocator_;
+  alignas(T) unsigned char storage_[sizeof(T)];
+
+  explicit InplaceControlBlock(const Allocator& allocator)
+      : BasicCounter<Policy>(&DestroyObject, &Deallocate), allocator_(allocator) {
   }
-  void AddWeakCounter() {
-    weak_counter_++;
+
+  static void DestroyObject(BasicCounter<Policy>* counter) noexcept {
+    auto* block = static_cast<InplaceControlBlock*>(counter);
+    ObjectTraits::destroy(block->allocator_, block->Object());
   }
-  void RemoveWeakCounter() {
-    weak_counter_--;
+
+  static void Deallocate(BasicCounter<Policy>* counter) noexcept {
+    auto* block = static_cast<InplaceControlBlock*>(counter);
+    BlockAllocator allocator(block->allocator_);
+    block->~InplaceControlBlock();
+    BlockTraits::deallocate(allocator, block, 1);
+  }
+
+ public:
+  template <class... Args>
+  static InplaceControlBlock* Create(const Allocator& allocator, Args&&... args) {
+    BlockAllocator block_allocator(allocator);
+    InplaceControlBlock* block = BlockTraits::allocate(block_allocator, 1);
+    bool block_constructed = false;
+    try {
+      ::new (static_cast<void*>(block)) InplaceControlBlock(allocator);
+      block_constructed = true;
+      ObjectTraits::construct(block->allocator_, block->Object(), std::forward<Args>(args)...);
+    } catch (...) {
+      if (block_constructed) {
+        block->~InplaceControlBlock();
+      }
+      BlockTraits::deallocate(block_allocator, block, 1);
+      throw;
+    }
+    return block;
+  }
+
+  T* Object() noexcept {
+    return std::launder(reinterpret_cast<T*>(storage_));
   }
 };
 
-template <class T>
+template <class T, class Policy = AtomicCounterPolicy, class Allocator, class... Args>
+SharedPtr<T, Policy> AllocateShared(const Allocator& allocator, Args&&... args);
+
+template <class T, class Policy>
 class SharedPtr {
  private:
+  template <class U, class P>
+  friend class WeakPtr;
+
+  template <class U, class P, class Allocator, class... Args>
+  friend SharedPtr<U, P> AllocateShared(const Allocator& allocator, Args&&... args);
+
+  using CounterType = BasicCounter<Policy>;
+
   T* pointer_;
-  Counter* refs_counter_;
+  CounterType* refs_counter_;
+
+  // Adopts a strong reference that has already been counted.
+  SharedPtr(T* pointer, CounterType* refs_counter) noexcept : pointer_(pointer), refs_counter_(refs_counter) {
+  }
+
+  static CounterType* MakeCounter(T* pointer) {
+    if (pointer == nullptr) {
+      return nullptr;
+    }
+    try {
+      return new PointerControlBlock<T, Policy>(pointer);
+    } catch (...) {
+      delete pointer;
+      throw;
+    }
+  }
 
  public:
-  explicit SharedPtr(const WeakPtr<T>& weak_ptr);
+  explicit SharedPtr(const WeakPtr<T, Policy>& weak_ptr);
 
   SharedPtr() noexcept {
     pointer_ = nullptr;
@@ -44,10 +252,10 @@ class SharedPtr {
 
   explicit SharedPtr(T* pointer) {
     pointer_ = pointer;
-    refs_counter_ = (pointer_ == nullptr ? nullptr : new Counter{1, 0});
+    refs_counter_ = MakeCounter(pointer);
   }
 
-  SharedPtr(const SharedPtr<T>& other_ptr) {
+  SharedPtr(const SharedPtr<T, Policy>& other_ptr) noexcept {
     pointer_ = other_ptr.pointer_;
     refs_counter_ = other_ptr.refs_counter_;
     if (refs_counter_) {
@@ -55,7 +263,7 @@ class SharedPtr {
     }
   }
 
-  SharedPtr<T>& operator=(const SharedPtr& other_ptr) {
+  SharedPtr<T, Policy>& operator=(const SharedPtr<T, Policy>& other_ptr) noexcept {
     if (this != &other_ptr) {
       CleanStrongPointer();
       pointer_ = other_ptr.pointer_;
@@ -67,14 +275,14 @@ class SharedPtr {
     return *this;
   }
 
-  SharedPtr(SharedPtr<T>&& rvalue_ptr) noexcept {
+  SharedPtr(SharedPtr<T, Policy>&& rvalue_ptr) noexcept {
     pointer_ = rvalue_ptr.pointer_;
     refs_counter_ = rvalue_ptr.refs_counter_;
     rvalue_ptr.pointer_ = nullptr;
     rvalue_ptr.refs_counter_ = nullptr;
   }
 
-  SharedPtr<T>& operator=(SharedPtr<T>&& rvalue_ptr) noexcept {
+  SharedPtr<T, Policy>& operator=(SharedPtr<T, Policy>&& rvalue_ptr) noexcept {
     if (this != &rvalue_ptr) {
       CleanStrongPointer();
       pointer_ = rvalue_ptr.pointer_;
@@ -87,17 +295,18 @@ class SharedPtr {
 
   void Reset(T* ptr = nullptr) {
     if (ptr != pointer_) {
+      CounterType* refs_counter = MakeCounter(ptr);
       CleanStrongPointer();
       pointer_ = ptr;
-      refs_counter_ = (ptr == nullptr ? nullptr : new Counter{1, 0});
+      refs_counter_ = refs_counter;
     }
   }
 
   [[nodiscard]] int32_t UseCount() const {  // NOLINT
-    return ((refs_counter_ == nullptr) ? 0 : refs_counter_->strong_counter_);
+    return ((refs_counter_ == nullptr) ? 0 : refs_counter_->StrongCount());
   }
 
-  void Swap(SharedPtr<T>& ptr) {
+  void Swap(SharedPtr<T, Policy>& ptr) {
     std::swap(pointer_, ptr.pointer_);
     std::swap(refs_counter_, ptr.refs_counter_);
   }
@@ -114,7 +323,7 @@ class SharedPtr {
     return pointer_;
   }
 
-  [[nodiscard]] Counter* GetCounter() const noexcept {
+  [[nodiscard]] CounterType* GetCounter() const noexcept {
     return refs_counter_;
   }
 
@@ -124,15 +333,10 @@ class SharedPtr {
 
   void CleanStrongPointer() noexcept {
     if (refs_counter_ != nullptr) {
-      refs_counter_->RemoveStrongCounter();
-      if (refs_counter_->strong_counter_ <= 0 && refs_counter_->weak_counter_ <= 0) {
-        delete pointer_;
-        delete refs_counter_;
-      } else if (refs_counter_->strong_counter_ <= 0 && refs_counter_->weak_counter_ > 0) {
-        delete pointer_;
-      }
+      refs_counter_->ReleaseStrong();
     }
     pointer_ = nullptr;
+    refs_counter_ = nullptr;
   }
 
   ~SharedPtr() {
@@ -140,11 +344,13 @@ class SharedPtr {
   }
 };
 
-template <class T>
+template <class T, class Policy>
 class WeakPtr {
  private:
+  using CounterType = BasicCounter<Policy>;
+
   T* pointer_;
-  Counter* refs_counter_;
+  CounterType* refs_counter_;
 
  public:
   WeakPtr() noexcept {
@@ -152,7 +358,7 @@ class WeakPtr {
     refs_counter_ = nullptr;
   }
 
-  WeakPtr(const WeakPtr<T>& other_ptr) noexcept {
+  WeakPtr(const WeakPtr<T, Policy>& other_ptr) noexcept {
     pointer_ = other_ptr.pointer_;
     refs_counter_ = other_ptr.refs_counter_;
     if (refs_counter_) {
@@ -160,7 +366,7 @@ class WeakPtr {
     }
   }
 
-  WeakPtr<T>& operator=(const WeakPtr& other_ptr) noexcept {
+  WeakPtr<T, Policy>& operator=(const WeakPtr<T, Policy>& other_ptr) noexcept {
     if (this != &other_ptr) {
       CleanWeakPointer();
       pointer_ = other_ptr.pointer_;
@@ -172,14 +378,14 @@ class WeakPtr {
     return *this;
   }
 
-  WeakPtr(WeakPtr<T>&& rvalue_ptr) noexcept {
+  WeakPtr(WeakPtr<T, Policy>&& rvalue_ptr) noexcept {
     pointer_ = rvalue_ptr.pointer_;
     refs_counter_ = rvalue_ptr.refs_counter_;
     rvalue_ptr.pointer_ = nullptr;
     rvalue_ptr.refs_counter_ = nullptr;
   }
 
-  WeakPtr<T>& operator=(WeakPtr<T>&& rvalue_ptr) noexcept {
+  WeakPtr<T, Policy>& operator=(WeakPtr<T, Policy>&& rvalue_ptr) noexcept {
     if (this != &rvalue_ptr) {
       CleanWeakPointer();
       pointer_ = rvalue_ptr.pointer_;
@@ -190,7 +396,7 @@ class WeakPtr {
     return *this;
   }
 
-  WeakPtr(const SharedPtr<T>& shared_ptr) {  // NOLINT
+  WeakPtr(const SharedPtr<T, Policy>& shared_ptr) noexcept {  // NOLINT
     pointer_ = shared_ptr.Get();
     refs_counter_ = shared_ptr.GetCounter();
     if (refs_counter_) {
@@ -198,7 +404,7 @@ class WeakPtr {
     }
   }
 
-  void Swap(WeakPtr& other_weak_ptr) {
+  void Swap(WeakPtr<T, Policy>& other_weak_ptr) {
     std::swap(pointer_, other_weak_ptr.pointer_);
     std::swap(refs_counter_, other_weak_ptr.refs_counter_);
   }
@@ -209,31 +415,32 @@ class WeakPtr {
   }
 
   [[nodiscard]] int32_t UseCount() const {  // NOLINT
-    return ((refs_counter_ == nullptr) ? 0 : refs_counter_->strong_counter_);
+    return ((refs_counter_ == nullptr) ? 0 : refs_counter_->StrongCount());
   }
 
+  // Only a hint when other threads own the object: it may expire right after this returns false.
   [[nodiscard]] bool Expired() const noexcept {
-    return (refs_counter_ == nullptr || refs_counter_->strong_counter_ <= 0);
+    return (refs_counter_ == nullptr || refs_counter_->StrongCount() <= 0);
   }
 
   T* Get() const noexcept {
     return pointer_;
   }
 
-  [[nodiscard]] Counter* GetCounter() const noexcept {
+  [[nodiscard]] CounterType* GetCounter() const noexcept {
     return refs_counter_;
   }
 
-  SharedPtr<T> Lock() const noexcept {
-    return (Expired() ? SharedPtr<T>() : SharedPtr<T>(*this));
+  SharedPtr<T, Policy> Lock() const noexcept {
+    if (refs_counter_ == nullptr || !refs_counter_->AddStrongCounterIfAlive()) {
+      return SharedPtr<T, Policy>();
+    }
+    return SharedPtr<T, Policy>(pointer_, refs_counter_);
   }
 
   void CleanWeakPointer() noexcept {
     if (refs_counter_) {
-      refs_counter_->RemoveWeakCounter();
-      if (refs_counter_->strong_counter_ <= 0 && refs_counter_->weak_counter_ <= 0) {
-        delete refs_counter_;
-      }
+      refs_counter_->ReleaseWeak();
       refs_counter_ = nullptr;
     }
   }
@@ -243,21 +450,26 @@ class WeakPtr {
   }
 };
 
-template <class T>
-SharedPtr<T>::SharedPtr(const WeakPtr<T>& weak_ptr) {
-  if (weak_ptr.Expired()) {
+template <class T, class Policy>
+SharedPtr<T, Policy>::SharedPtr(const WeakPtr<T, Policy>& weak_ptr) {
+  if (weak_ptr.GetCounter() == nullptr || !weak_ptr.GetCounter()->AddStrongCounterIfAlive()) {
     throw BadWeakPtr{};
   }
   pointer_ = weak_ptr.Get();
   refs_counter_ = weak_ptr.GetCounter();
-  if (refs_counter_) {
-    refs_counter_->AddStrongCounter();
-  }
+}
+
+// Builds the object inside its control block with memory from allocator, e.g. a PoolAllocator over a shared
+// SizeClassPool for many small short-lived objects.
+template <class T, class Policy, class Allocator, class... Args>
+SharedPtr<T, Policy> AllocateShared(const Allocator& allocator, Args&&... args) {
+  auto* block = InplaceControlBlock<T, Policy, Allocator>::Create(allocator, std::forward<Args>(args)...);
+  return SharedPtr<T, Policy>(block->Object(), block);
 }
 
 template <class T, class... Args>
 SharedPtr<T> MakeShared(Args&&... args) {
-  return SharedPtr<T>(new T(std::forward<Args>(args)...));
+  return AllocateShared<T>(std::allocator<T>(), std::forward<Args>(args)...);
 };
 
 #endif
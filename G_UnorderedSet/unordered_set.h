@@ -4,63 +4,111 @@
 #include <vector>
 #include <list>
 #include <iterator>
+#include <memory>
 #include <utility>
 #include <algorithm>
 
-template <class KeyT>
+template <class KeyT, class Allocator = std::allocator<KeyT>>
 class UnorderedSet {
  private:
-  std::vector<std::list<KeyT>> table_;
+  using AllocatorTraits = std::allocator_traits<Allocator>;
+  using BucketType = std::list<KeyT, Allocator>;
+  using TableAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<BucketType>;
+  using TableType = std::vector<BucketType, TableAllocator>;
+
+  Allocator allocator_;
+  TableType table_;
   size_t n_elements_;
 
+  // Buckets and their nodes are all drawn from allocator_, so nodes can be spliced between tables.
+  static TableType MakeTable(size_t bucket_count, const Allocator& allocator) {
+    return TableType(bucket_count, BucketType(allocator), TableAllocator(allocator));
+  }
+
+  TableType MakeTable(size_t bucket_count) const {
+    return MakeTable(bucket_count, allocator_);
+  }
+
+  // Copies source bucket by bucket into nodes drawn from allocator, keeping every key in the same bucket.
+  static TableType CopyTable(const TableType& source, const Allocator& allocator) {
+    TableType table = MakeTable(source.size(), allocator);
+    for (size_t i = 0u; i < source.size(); ++i) {
+      table[i].assign(source[i].begin(), source[i].end());
+    }
+    return table;
+  }
+
+  // Frees the current nodes with the allocator that made them, then adopts table, whose nodes come from allocator.
+  void ReplaceTable(TableType&& table, const Allocator& allocator) {
+    table_.clear();
+    table_.shrink_to_fit();
+    table_ = std::move(table);
+    allocator_ = allocator;
+  }
+
   size_t HashFunction(const KeyT& key) const {
     return std::hash<KeyT>{}(key) % table_.size();
   }
 
  public:
-  UnorderedSet() {
-    table_ = std::vector<std::list<KeyT>>();
+  UnorderedSet() : UnorderedSet(Allocator()) {
+  }
+
+  explicit UnorderedSet(const Allocator& allocator) : allocator_(allocator), table_(TableAllocator(allocator)) {
     n_elements_ = 0;
   }
 
-  explicit UnorderedSet(size_t count) {
+  explicit UnorderedSet(size_t count, const Allocator& allocator = Allocator())
+      : allocator_(allocator), table_(MakeTable(count)) {
     n_elements_ = 0;
-    table_ = std::vector<std::list<KeyT>>(count);
   }
 
   template <class IterT>
-  UnorderedSet(IterT begin, IterT end) {
+  UnorderedSet(IterT begin, IterT end, const Allocator& allocator = Allocator())
+      : allocator_(allocator), table_(TableAllocator(allocator)) {
     size_t n = std::distance(begin, end);
     n_elements_ = n;
-    table_ = std::vector<std::list<KeyT>>(n);
+    table_ = MakeTable(n);
     for (IterT it = begin; it != end; ++it) {
       KeyT value = *it;
       table_[HashFunction(value)].push_back(value);
     }
   }
 
-  UnorderedSet(const UnorderedSet<KeyT>& other_set) {
-    table_ = other_set.table_;
+  UnorderedSet(const UnorderedSet<KeyT, Allocator>& other_set)
+      : allocator_(AllocatorTraits::select_on_container_copy_construction(other_set.allocator_)),
+        table_(CopyTable(other_set.table_, allocator_)) {
     n_elements_ = other_set.n_elements_;
   }
 
-  UnorderedSet<KeyT>& operator=(const UnorderedSet<KeyT>& other_set) {
+  UnorderedSet<KeyT, Allocator>& operator=(const UnorderedSet<KeyT, Allocator>& other_set) {
     if (this != &other_set) {
-      table_ = other_set.table_;
+      Allocator allocator =
+          (AllocatorTraits::propagate_on_container_copy_assignment::value ? other_set.allocator_ : allocator_);
+      ReplaceTable(CopyTable(other_set.table_, allocator), allocator);
       n_elements_ = other_set.n_elements_;
     }
     return *this;
   }
 
-  UnorderedSet(UnorderedSet<KeyT>&& rvalue_other_set) noexcept {
-    table_ = std::move(rvalue_other_set.table_);
+  UnorderedSet(UnorderedSet<KeyT, Allocator>&& rvalue_other_set) noexcept
+      : allocator_(rvalue_other_set.allocator_), table_(std::move(rvalue_other_set.table_)) {
     n_elements_ = rvalue_other_set.n_elements_;
     rvalue_other_set.n_elements_ = 0;
   }
 
-  UnorderedSet<KeyT>& operator=(UnorderedSet<KeyT>&& rvalue_other_set) noexcept {
+  // Steals the nodes when the allocator propagates or both allocators are equal; otherwise copies the keys into
+  // nodes from this set's allocator.
+  UnorderedSet<KeyT, Allocator>& operator=(UnorderedSet<KeyT, Allocator>&& rvalue_other_set) noexcept(
+      AllocatorTraits::propagate_on_container_move_assignment::value || AllocatorTraits::is_always_equal::value) {
     if (this != &rvalue_other_set) {
-      table_ = std::move(rvalue_other_set.table_);
+      if (AllocatorTraits::propagate_on_container_move_assignment::value ||
+          allocator_ == rvalue_other_set.allocator_) {
+        ReplaceTable(std::move(rvalue_other_set.table_), rvalue_other_set.allocator_);
+      } else {
+        ReplaceTable(CopyTable(rvalue_other_set.table_, allocator_), allocator_);
+        rvalue_other_set.table_.clear();
+      }
       n_elements_ = rvalue_other_set.n_elements_;
       rvalue_other_set.n_elements_ = 0;
     }
@@ -98,11 +146,11 @@ class UnorderedSet {
 
   void Rehash(size_t new_bucket_count) {
     if (new_bucket_count >= n_elements_) {
-      std::vector<std::list<KeyT>> tmp_table(new_bucket_count);
-      for (const std::list<KeyT>& cur_bucket : table_) {
-        for (const KeyT& cur_value : cur_bucket) {
-          size_t new_hash = std::hash<KeyT>{}(cur_value) % new_bucket_count;
-          tmp_table[new_hash].push_back(cur_value);
+      TableType tmp_table = MakeTable(new_bucket_count);
+      for (BucketType& cur_bucket : table_) {
+        while (!cur_bucket.empty()) {
+          size_t new_hash = std::hash<KeyT>{}(cur_bucket.front()) % new_bucket_count;
+          tmp_table[new_hash].splice(tmp_table[new_hash].end(), cur_bucket, cur_bucket.begin());
         }
       }
       std::swap(table_, tmp_table);
@@ -135,7 +183,7 @@ class UnorderedSet {
   void Insert(const KeyT& value) {
     if (!Find(value)) {
       if (BucketCount() == 0) {
-        table_ = std::vector<std::list<KeyT>>(1);
+        table_ = MakeTable(1);
       }
       if (LoadFactor() >= 1.0) {
         Reserve(n_elements_ * 2);
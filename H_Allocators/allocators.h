@@ -0,0 +1,285 @@
+#ifndef LARGETASKS_ALLOCATORS_H
+#define LARGETASKS_ALLOCATORS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <utility>
+
+// Hands out memory by bumping a pointer through large upstream chunks. Deallocation is a no-op; everything is
+// returned at once by Release() or the destructor, which suits request-scoped build-then-discard workloads.
+// Not thread-safe.
+class MonotonicArena {
+ private:
+  struct ChunkHeader {
+    ChunkHeader* next_;
+    size_t size_;
+  };
+
+  static constexpr size_t kDefaultChunkSize = 64u * 1024u;
+  static constexpr size_t kChunkAlignment = alignof(std::max_align_t);
+
+  ChunkHeader* chunks_ = nullptr;
+  char* current_ = nullptr;
+  char* end_ = nullptr;
+  size_t initial_chunk_size_ = kDefaultChunkSize;
+  size_t next_chunk_size_ = kDefaultChunkSize;
+  size_t allocations_number_ = 0;
+  size_t upstream_allocations_number_ = 0;
+  size_t bytes_allocated_ = 0;
+
+  void AddChunk(size_t min_bytes) {
+    size_t chunk_size = std::max(next_chunk_size_, min_bytes + sizeof(ChunkHeader) + kChunkAlignment);
+    auto* chunk = static_cast<ChunkHeader*>(::operator new(chunk_size, std::align_val_t{kChunkAlignment}));
+    chunk->next_ = chunks_;
+    chunk->size_ = chunk_size;
+    chunks_ = chunk;
+    current_ = reinterpret_cast<char*>(chunk) + sizeof(ChunkHeader);
+    end_ = reinterpret_cast<char*>(chunk) + chunk_size;
+    next_chunk_size_ = chunk_size * 2;
+    ++upstream_allocations_number_;
+  }
+
+ public:
+  MonotonicArena() noexcept = default;
+
+  explicit MonotonicArena(size_t initial_chunk_size) noexcept
+      : initial_chunk_size_(std::max<size_t>(initial_chunk_size, sizeof(ChunkHeader) + kChunkAlignment)),
+        next_chunk_size_(initial_chunk_size_) {
+  }
+
+  MonotonicArena(const MonotonicArena&) = delete;
+  MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+  void* Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+    auto align_up = [alignment](char* pointer) {
+      auto address = reinterpret_cast<uintptr_t>(pointer);
+      return reinterpret_cast<char*>((address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1));
+    };
+    char* result = (current_ == nullptr ? nullptr : align_up(current_));
+    if (result == nullptr || result > end_ || static_cast<size_t>(end_ - result) < bytes) {
+      AddChunk(bytes + alignment);
+      result = align_up(current_);
+    }
+    current_ = result + bytes;
+    ++allocations_number_;
+    bytes_allocated_ += bytes;
+    return result;
+  }
+
+  void Deallocate(void*, size_t) noexcept {
+  }
+
+  // Frees every chunk; chunk sizes start over from the initial size, so an arena reused per request stays small.
+  void Release() noexcept {
+    while (chunks_ != nullptr) {
+      ChunkHeader* next = chunks_->next_;
+      ::operator delete(chunks_, std::align_val_t{kChunkAlignment});
+      chunks_ = next;
+    }
+    current_ = nullptr;
+    end_ = nullptr;
+    next_chunk_size_ = initial_chunk_size_;
+  }
+
+  [[nodiscard]] size_t AllocationsNumber() const noexcept {
+    return allocations_number_;
+  }
+
+  [[nodiscard]] size_t UpstreamAllocationsNumber() const noexcept {
+    return upstream_allocations_number_;
+  }
+
+  [[nodiscard]] size_t BytesAllocated() const noexcept {
+    return bytes_allocated_;
+  }
+
+  ~MonotonicArena() {
+    Release();
+  }
+};
+
+// Recycles blocks of up to kMaxBlockSize bytes through one free list per 16-byte size class; the blocks are
+// carved from chunks taken from the global heap and are only returned to it on destruction. Larger or
+// over-aligned requests go straight to the global heap. Not thread-safe.
+class SizeClassPool {
+ private:
+  struct FreeBlock {
+    FreeBlock* next_;
+  };
+
+  struct ChunkHeader {
+    ChunkHeader* next_;
+  };
+
+  static constexpr size_t kGranularity = alignof(std::max_align_t);
+  static constexpr size_t kMaxBlockSize = 512;
+  static constexpr size_t kClassesNumber = kMaxBlockSize / kGranularity;
+  static constexpr size_t kChunkSize = 64u * 1024u;
+
+  FreeBlock* free_lists_[kClassesNumber] = {};
+  ChunkHeader* chunks_ = nullptr;
+  size_t allocations_number_ = 0;
+  size_t upstream_allocations_number_ = 0;
+
+  static size_t SizeClass(size_t bytes) noexcept {
+    return (std::max<size_t>(bytes, 1u) + kGranularity - 1) / kGranularity - 1;
+  }
+
+  static bool IsPooled(size_t bytes, size_t alignment) noexcept {
+    return bytes <= kMaxBlockSize && alignment <= kGranularity;
+  }
+
+  // Splits a fresh chunk into blocks of one size class and threads them onto its free list.
+  void Refill(size_t size_class) {
+    size_t block_size = (size_class + 1) * kGranularity;
+    auto* chunk = static_cast<ChunkHeader*>(::operator new(kChunkSize));
+    chunk->next_ = chunks_;
+    chunks_ = chunk;
+    ++upstream_allocations_number_;
+
+    char* first = reinterpret_cast<char*>(chunk) + kGranularity;
+    size_t blocks_number = (kChunkSize - kGranularity) / block_size;
+    for (size_t i = blocks_number; i > 0; --i) {
+      auto* block = reinterpret_cast<FreeBlock*>(first + (i - 1) * block_size);
+      block->next_ = free_lists_[size_class];
+      free_lists_[size_class] = block;
+    }
+  }
+
+ public:
+  SizeClassPool() noexcept = default;
+
+  SizeClassPool(const SizeClassPool&) = delete;
+  SizeClassPool& operator=(const SizeClassPool&) = delete;
+
+  void* Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+    ++allocations_number_;
+    if (!IsPooled(bytes, alignment)) {
+      ++upstream_allocations_number_;
+      return ::operator new(bytes, std::align_val_t{alignment});
+    }
+    size_t size_class = SizeClass(bytes);
+    if (free_lists_[size_class] == nullptr) {
+      Refill(size_class);
+    }
+    FreeBlock* block = free_lists_[size_class];
+    free_lists_[size_class] = block->next_;
+    return block;
+  }
+
+  void Deallocate(void* pointer, size_t bytes, size_t alignment = alignof(std::max_align_t)) noexcept {
+    if (!IsPooled(bytes, alignment)) {
+      ::operator delete(pointer, std::align_val_t{alignment});
+      return;
+    }
+    auto* block = static_cast<FreeBlock*>(pointer);
+    size_t size_class = SizeClass(bytes);
+    block->next_ = free_lists_[size_class];
+    free_lists_[size_class] = block;
+  }
+
+  [[nodiscard]] size_t AllocationsNumber() const noexcept {
+    return allocations_number_;
+  }
+
+  [[nodiscard]] size_t UpstreamAllocationsNumber() const noexcept {
+    return upstream_allocations_number_;
+  }
+
+  ~SizeClassPool() {
+    while (chunks_ != nullptr) {
+      ChunkHeader* next = chunks_->next_;
+      ::operator delete(chunks_);
+      chunks_ = next;
+    }
+  }
+};
+
+// Standard-conforming allocator adaptors over the two resources above. They only hold a pointer to the
+// resource, which must outlive every container using it; copies and rebinds share that resource.
+template <class T>
+class ArenaAllocator {
+ private:
+  template <class U>
+  friend class ArenaAllocator;
+
+  MonotonicArena* arena_;
+
+ public:
+  using value_type = T;  // NOLINT
+
+  explicit ArenaAllocator(MonotonicArena& arena) noexcept : arena_(&arena) {
+  }
+
+  template <class U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena_) {  // NOLINT
+  }
+
+  T* allocate(size_t n) {  // NOLINT
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* pointer, size_t n) noexcept {  // NOLINT
+    arena_->Deallocate(pointer, n * sizeof(T));
+  }
+
+  [[nodiscard]] MonotonicArena& Resource() const noexcept {
+    return *arena_;
+  }
+
+  template <class U>
+  bool operator==(const ArenaAllocator<U>& other) const noexcept {
+    return arena_ == other.arena_;
+  }
+
+  template <class U>
+  bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+    return arena_ != other.arena_;
+  }
+};
+
+template <class T>
+class PoolAllocator {
+ private:
+  template <class U>
+  friend class PoolAllocator;
+
+  SizeClassPool* pool_;
+
+ public:
+  using value_type = T;  // NOLINT
+
+  explicit PoolAllocator(SizeClassPool& pool) noexcept : pool_(&pool) {
+  }
+
+  template <class U>
+  PoolAllocator(const PoolAllocator<U>& other) noexcept : pool_(other.pool_) {  // NOLINT
+  }
+
+  T* allocate(size_t n) {  // NOLINT
+    return static_cast<T*>(pool_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* pointer, size_t n) noexcept {  // NOLINT
+    pool_->Deallocate(pointer, n * sizeof(T), alignof(T));
+  }
+
+  [[nodiscard]] SizeClassPool& Resource() const noexcept {
+    return *pool_;
+  }
+
+  template <class U>
+  bool operator==(const PoolAllocator<U>& other) const noexcept {
+    return pool_ == other.pool_;
+  }
+
+  template <class U>
+  bool operator!=(const PoolAllocator<U>& other) const noexcept {
+    return pool_ != other.pool_;
+  }
+};
+
+#endif
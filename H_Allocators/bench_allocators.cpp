@@ -0,0 +1,129 @@
+// Global heap allocations and throughput of Vector and UnorderedSet on the default allocator, a MonotonicArena and
+// a SizeClassPool, for an insert-heavy pattern and a build-then-discard (request-scoped) pattern.
+// Build and run from the repository root:
+//   g++ -std=c++17 -O2 -I. H_Allocators/bench_allocators.cpp -o bench_allocators && ./bench_allocators
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+#include "C_Vector/vector.h"
+#include "G_UnorderedSet/unordered_set.h"
+#include "H_Allocators/allocators.h"
+
+namespace {
+
+size_t heap_allocations = 0;
+
+constexpr size_t kInsertKeys = 1u << 20;
+constexpr size_t kRequests = 2000;
+constexpr size_t kKeysPerRequest = 1000;
+
+}  // namespace
+
+// Every global allocation in this program, including the resources' own upstream chunks, is counted here.
+void* operator new(size_t bytes) {
+  ++heap_allocations;
+  if (void* pointer = std::malloc(bytes == 0 ? 1 : bytes)) {
+    return pointer;
+  }
+  throw std::bad_alloc{};
+}
+
+void* operator new(size_t bytes, std::align_val_t alignment) {
+  ++heap_allocations;
+  auto align = static_cast<size_t>(alignment);
+  if (void* pointer = std::aligned_alloc(align, (std::max<size_t>(bytes, 1u) + align - 1) / align * align)) {
+    return pointer;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+namespace {
+
+template <class Function>
+void Report(const char* pattern, const char* allocator_name, const Function& function) {
+  size_t allocations_before = heap_allocations;
+  auto start = std::chrono::steady_clock::now();
+  function();
+  double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  std::printf("%-20s %-10s %10.1f ms %12zu heap allocations\n", pattern, allocator_name, elapsed,
+              heap_allocations - allocations_before);
+}
+
+// Inserts kInsertKeys distinct keys into one set and pushes them into one vector.
+template <class Allocator>
+void InsertHeavy(const Allocator& allocator) {
+  UnorderedSet<int, Allocator> set(allocator);
+  Vector<int, Allocator> keys(allocator);
+  for (size_t i = 0u; i < kInsertKeys; ++i) {
+    set.Insert(static_cast<int>(i * 2654435761u));
+    keys.PushBack(static_cast<int>(i));
+  }
+}
+
+// One request: build a small set and vector, look a few keys up, throw everything away.
+template <class Allocator>
+size_t ServeRequest(const Allocator& allocator, size_t request) {
+  UnorderedSet<int, Allocator> set(allocator);
+  Vector<int, Allocator> keys(allocator);
+  for (size_t i = 0u; i < kKeysPerRequest; ++i) {
+    set.Insert(static_cast<int>(request * kKeysPerRequest + i));
+    keys.PushBack(static_cast<int>(i));
+  }
+  return (set.Find(static_cast<int>(request * kKeysPerRequest)) ? keys.Size() : 0u);
+}
+
+}  // namespace
+
+int main() {
+  Report("insert-heavy", "heap", [] { InsertHeavy(std::allocator<int>()); });
+  Report("insert-heavy", "arena", [] {
+    MonotonicArena arena;
+    InsertHeavy(ArenaAllocator<int>(arena));
+  });
+  Report("insert-heavy", "pool", [] {
+    SizeClassPool pool;
+    InsertHeavy(PoolAllocator<int>(pool));
+  });
+
+  size_t served = 0;
+  Report("build-then-discard", "heap", [&] {
+    for (size_t r = 0u; r < kRequests; ++r) {
+      served += ServeRequest(std::allocator<int>(), r);
+    }
+  });
+  Report("build-then-discard", "arena", [&] {
+    MonotonicArena arena;
+    for (size_t r = 0u; r < kRequests; ++r) {
+      served += ServeRequest(ArenaAllocator<int>(arena), r);
+      arena.Release();
+    }
+  });
+  Report("build-then-discard", "pool", [&] {
+    SizeClassPool pool;
+    for (size_t r = 0u; r < kRequests; ++r) {
+      served += ServeRequest(PoolAllocator<int>(pool), r);
+    }
+  });
+  std::printf("(%zu keys inserted; %zu requests of %zu keys, checksum %zu)\n", kInsertKeys, kRequests,
+              kKeysPerRequest, served);
+  return 0;
+}
@@ -0,0 +1,56 @@
+// Random gather over a large Vector<uint64_t> backed by the heap and by HugePageAllocator.
+// Build and run from the repository root (the argument is the array size in MiB, 1024 by default):
+//   g++ -std=c++17 -O2 -I. H_Allocators/bench_huge_page_allocator.cpp -o bench_huge_page_allocator
+//   ./bench_huge_page_allocator 1024
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#include "C_Vector/vector.h"
+#include "H_Allocators/huge_page_allocator.h"
+
+namespace {
+
+constexpr size_t kGathers = 1u << 24;
+
+uint64_t NextRandom(uint64_t& state) {
+  state ^= state << 13u;
+  state ^= state >> 7u;
+  state ^= state << 17u;
+  return state;
+}
+
+template <class Allocator>
+void RunGather(const char* name, size_t n) {
+  auto start = std::chrono::steady_clock::now();
+  Vector<uint64_t, Allocator> values(n);
+  for (size_t i = 0u; i < n; ++i) {
+    values[i] = i;
+  }
+  auto filled = std::chrono::steady_clock::now();
+
+  uint64_t state = 0x9E3779B97F4A7C15ull;
+  uint64_t sum = 0;
+  for (size_t i = 0u; i < kGathers; ++i) {
+    sum += values[NextRandom(state) % n];
+  }
+  auto gathered = std::chrono::steady_clock::now();
+
+  std::printf("%-10s fill %8.1f ms   %zu random gathers %8.1f ms   (checksum %llu)\n", name,
+              std::chrono::duration<double, std::milli>(filled - start).count(), kGathers,
+              std::chrono::duration<double, std::milli>(gathered - filled).count(),
+              static_cast<unsigned long long>(sum));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  size_t mebibytes = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024u);
+  size_t n = mebibytes * 1024u * 1024u / sizeof(uint64_t);
+  std::printf("array of %zu MiB (%zu elements)\n", mebibytes, n);
+  RunGather<std::allocator<uint64_t>>("heap", n);
+  RunGather<HugePageAllocator<uint64_t>>("huge pages", n);
+  return 0;
+}
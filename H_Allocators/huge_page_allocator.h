@@ -0,0 +1,222 @@
+#ifndef LARGETASKS_HUGE_PAGE_ALLOCATOR_H
+#define LARGETASKS_HUGE_PAGE_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Allocations of at least kHugePageThreshold bytes are served by private anonymous mmap regions aligned to 2 MiB and
+// advised with MADV_HUGEPAGE, so large arrays are backed by huge pages and random access misses the TLB far less
+// often.
+// Smaller requests use the global heap. Containers that know about the two optional hooks below get more:
+//   Remap(pointer, old_n, new_n) grows or shrinks a mapping in place with mremap instead of copy-and-free and
+//   returns nullptr when it cannot;
+//   IsZeroFilled(n) reports that a fresh allocation of n elements is already zeroed by the kernel.
+//
+// Given a file descriptor, every allocation maps that file (MAP_SHARED, resized with ftruncate) whatever its size,
+// so the array persists in the file. Such an allocation keeps the file's bytes, which is what IsZeroFilled
+// advertises for a file that is new or just truncated; reopening an existing file exposes its persisted elements.
+// Only one live allocation may use a given descriptor, so a file-backed allocator must only ever grow by Remap:
+// it is refused for element types a container would relocate by copying (not trivially copyable), a failed Remap
+// throws std::bad_alloc instead of letting the container map the file a second time, and container copies get an
+// anonymous allocator. Outside Linux everything falls back to the global heap.
+template <class T>
+class HugePageAllocator {
+ private:
+  template <class U>
+  friend class HugePageAllocator;
+
+  static constexpr size_t kHugePageSize = 2u * 1024u * 1024u;
+
+  size_t threshold_;
+  int fd_;
+
+  [[nodiscard]] bool IsMapped(size_t n) const noexcept {
+#if defined(__linux__)
+    return fd_ >= 0 || n * sizeof(T) >= threshold_;
+#else
+    static_cast<void>(n);
+    return false;
+#endif
+  }
+
+#if defined(__linux__)
+  [[nodiscard]] size_t MappingSize(size_t n) const noexcept {
+    size_t granularity = (fd_ >= 0 ? static_cast<size_t>(sysconf(_SC_PAGESIZE)) : kHugePageSize);
+    return (std::max<size_t>(n * sizeof(T), 1u) + granularity - 1) / granularity * granularity;
+  }
+
+  // Maps size bytes (a multiple of kHugePageSize) at a kHugePageSize-aligned address: MADV_HUGEPAGE only takes
+  // effect on whole aligned huge pages, so the mapping is over-allocated by one huge page and trimmed.
+  static void* MapAnonymousAligned(size_t size) noexcept {
+    size_t padded_size = size + kHugePageSize;
+    void* raw = mmap(nullptr, padded_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+      return MAP_FAILED;
+    }
+    auto begin = reinterpret_cast<uintptr_t>(raw);
+    uintptr_t aligned = (begin + kHugePageSize - 1) & ~(uintptr_t{kHugePageSize} - 1);
+    if (aligned != begin) {
+      munmap(raw, aligned - begin);
+    }
+    if (begin + padded_size != aligned + size) {
+      munmap(reinterpret_cast<void*>(aligned + size), begin + padded_size - (aligned + size));
+    }
+    auto* mapping = reinterpret_cast<void*>(aligned);
+#if defined(MADV_HUGEPAGE)
+    madvise(mapping, size, MADV_HUGEPAGE);
+#endif
+    return mapping;
+  }
+
+  // The file is extended before the mapping grows and truncated only after it shrinks, so the mapping never
+  // covers bytes past the end of the file.
+  T* RemapFile(T* pointer, size_t old_n, size_t new_n) {
+    size_t old_size = MappingSize(old_n);
+    size_t new_size = MappingSize(new_n);
+    if (new_n > old_n && ftruncate(fd_, static_cast<off_t>(new_n * sizeof(T))) != 0) {
+      throw std::bad_alloc();
+    }
+    void* mapping = pointer;
+    if (old_size != new_size) {
+      mapping = mremap(pointer, old_size, new_size, MREMAP_MAYMOVE);
+    }
+    if (mapping == MAP_FAILED) {
+      if (new_n > old_n) {
+        static_cast<void>(ftruncate(fd_, static_cast<off_t>(old_n * sizeof(T))));
+      }
+      throw std::bad_alloc();
+    }
+    if (new_n < old_n) {
+      static_cast<void>(ftruncate(fd_, static_cast<off_t>(new_n * sizeof(T))));
+    }
+    return static_cast<T*>(mapping);
+  }
+#endif
+
+  void CheckFileBacking() const {
+    if (fd_ >= 0 && !std::is_trivially_copyable_v<T>) {
+      throw std::invalid_argument("HugePageAllocator: file-backed storage needs trivially copyable elements");
+    }
+  }
+
+ public:
+  using value_type = T;  // NOLINT
+
+  static constexpr size_t kHugePageThreshold = kHugePageSize;
+
+  explicit HugePageAllocator(size_t threshold = kHugePageThreshold, int fd = -1) : threshold_(threshold), fd_(fd) {
+    CheckFileBacking();
+  }
+
+  template <class U>
+  HugePageAllocator(const HugePageAllocator<U>& other)  // NOLINT
+      : threshold_(other.threshold_), fd_(other.fd_) {
+    CheckFileBacking();
+  }
+
+  // A container copy must not map the same file: it gets an anonymous allocator with the same threshold.
+  [[nodiscard]] HugePageAllocator<T> select_on_container_copy_construction() const noexcept {  // NOLINT
+    HugePageAllocator<T> copy(*this);
+    copy.fd_ = -1;
+    return copy;
+  }
+
+  T* allocate(size_t n) {  // NOLINT
+    if (!IsMapped(n)) {
+      return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignof(T)}));
+    }
+#if defined(__linux__)
+    size_t size = MappingSize(n);
+    void* mapping = MAP_FAILED;
+    if (fd_ >= 0) {
+      if (ftruncate(fd_, static_cast<off_t>(n * sizeof(T))) == 0) {
+        mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+      }
+    } else {
+      mapping = MapAnonymousAligned(size);
+    }
+    if (mapping == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(mapping);
+#endif
+  }
+
+  void deallocate(T* pointer, size_t n) noexcept {  // NOLINT
+    if (!IsMapped(n)) {
+      ::operator delete(pointer, std::align_val_t{alignof(T)});
+      return;
+    }
+#if defined(__linux__)
+    munmap(pointer, MappingSize(n));
+#endif
+  }
+
+  // Returns nullptr when the caller should fall back to allocate-copy-free. File-backed storage cannot fall back,
+  // so its failures throw std::bad_alloc and leave the old mapping and the file untouched.
+  T* Remap(T* pointer, size_t old_n, size_t new_n) {
+#if defined(__linux__)
+    if (pointer == nullptr || !IsMapped(old_n) || !IsMapped(new_n)) {
+      if (fd_ >= 0) {
+        throw std::bad_alloc();
+      }
+      return nullptr;
+    }
+    if (fd_ >= 0) {
+      return RemapFile(pointer, old_n, new_n);
+    }
+    size_t old_size = MappingSize(old_n);
+    size_t new_size = MappingSize(new_n);
+    if (old_size == new_size) {
+      return pointer;
+    }
+    // Growing or shrinking in place keeps the huge-page alignment; a move goes to a freshly aligned region.
+    void* mapping = mremap(pointer, old_size, new_size, 0);
+    if (mapping == MAP_FAILED) {
+      void* target = MapAnonymousAligned(new_size);
+      if (target == MAP_FAILED) {
+        return nullptr;
+      }
+      mapping = mremap(pointer, old_size, new_size, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+      if (mapping == MAP_FAILED) {
+        munmap(target, new_size);
+        return nullptr;
+      }
+    }
+#if defined(MADV_HUGEPAGE)
+    madvise(mapping, new_size, MADV_HUGEPAGE);
+#endif
+    return static_cast<T*>(mapping);
+#else
+    static_cast<void>(pointer);
+    static_cast<void>(old_n);
+    static_cast<void>(new_n);
+    return nullptr;
+#endif
+  }
+
+  [[nodiscard]] bool IsZeroFilled(size_t n) const noexcept {
+    return IsMapped(n);
+  }
+
+  template <class U>
+  bool operator==(const HugePageAllocator<U>& other) const noexcept {
+    return threshold_ == other.threshold_ && fd_ == other.fd_;
+  }
+
+  template <class U>
+  bool operator!=(const HugePageAllocator<U>& other) const noexcept {
+    return !(*this == other);
+  }
+};
+
+#endif